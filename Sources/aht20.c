@@ -38,8 +38,15 @@
  *              Humidity(%)     = Raw_Humidity × 100 / 2^20
  * 
  * @note     FUNCTION SUMMARY:
- *           - aht20_Init    : Initialize sensor with soft reset and calibration verification
- *           - aht20_getData : Trigger measurement, read data, validate CRC, convert to physical units
+ *           - aht20_Init       : Initialize sensor with soft reset and calibration verification
+ *           - aht20_getData    : Trigger measurement, read data, validate CRC, convert to physical units
+ *           - aht20_Trigger    : Send trigger command only (non-blocking)
+ *           - aht20_readPacked : Read 7-byte frame, validate flags and CRC, return 5 packed bytes
+ *           - aht20_readData   : aht20_readPacked() + aht20_Unpack()
+ *           - aht20_Unpack     : Extract 20-bit raw values and convert to physical units
+ *           - aht20_getLast    : Last valid sample, converted once and cached (__AHT20_CACHE)
+ *           - aht20_checkFrame   : Validate flags and CRC of one captured 7-byte frame
+ *           - aht20_decodeFrames : Validate and convert captured 7-byte frames in bulk (__AHT20_DECODE)
  * 
  * @note     CRC-8 Configuration (AHT20 specific):
  *           - Polynomial: 0x31 (x^8 + x^5 + x^4 + 1)
@@ -55,6 +62,293 @@
  */
 
 #include "aht20.h"
+#include "aht20_internal.h"
+
+
+/* ============================================================================
+ *                       PHASE PROFILER
+ * ============================================================================ */
+#if __AHT20_PROFILE
+    #define __AHT20_PROF_START()       uint16_t _Prof_T = TCNT1                  /**< Timestamp at function entry */
+    #define __AHT20_PROF_MARK(_Phase)  _Prof_T = aht20_profMark(_Phase, _Prof_T) /**< Close phase, open the next one */
+    #define __AHT20_PROF_MEASURE(_On)  _aht20_ProfMeasure = (_On)                 /**< Enter/leave the measurement path */
+    #define __AHT20_PROF_MARK_MEASURE(_Phase)  if(_aht20_ProfMeasure) { __AHT20_PROF_MARK(_Phase); }  /**< Mark only for a fresh measurement */
+
+AHT20_ProfStat_T aht20_Profile[AHT20_Prof_Count];
+static bool _aht20_ProfMeasure = false;                    /**< aht20_Unpack() runs for aht20_readData(), not getLast()/replay */
+
+/* -------------------------------------------------------
+ * @brief Account the time since _Start to one phase
+ * @retval New start timestamp (taken after bookkeeping, so it is not counted)
+ * ------------------------------------------------------- */
+static uint16_t aht20_profMark(AHT20_Prof_T _Phase, uint16_t _Start)
+{
+    uint16_t _Ticks = TCNT1 - _Start;                      /**< Unsigned subtraction handles one timer wrap */
+    AHT20_ProfStat_T* _Stat = &aht20_Profile[_Phase];
+
+    if(_Ticks < _Stat->Min)
+    {
+        _Stat->Min = _Ticks;
+    };
+    if(_Ticks > _Stat->Max)
+    {
+        _Stat->Max = _Ticks;
+    };
+    _Stat->Sum += _Ticks;
+    _Stat->Count++;
+
+    return TCNT1;
+};
+
+/* -------------------------------------------------------
+ * @brief Clear all phase statistics
+ * ------------------------------------------------------- */
+void aht20_profReset(void)
+{
+    for(uint8_t _Idx = 0; _Idx < AHT20_Prof_Count; _Idx++)
+    {
+        aht20_Profile[_Idx].Min = 0xFFFF;
+        aht20_Profile[_Idx].Max = 0;
+        aht20_Profile[_Idx].Sum = 0;
+        aht20_Profile[_Idx].Count = 0;
+    };
+};
+
+/* -------------------------------------------------------
+ * @brief Start Timer1 free-running and clear statistics
+ * ------------------------------------------------------- */
+void aht20_profInit(void)
+{
+    TCCR1A = 0x00;                                         /**< Normal mode, no output compare */
+    TCCR1B = __AHT20_PROFILE_CLK;                          /**< Free running with selected prescaler */
+    aht20_profReset();
+};
+
+/* -------------------------------------------------------
+ * @brief Get statistics of one phase
+ * ------------------------------------------------------- */
+const AHT20_ProfStat_T* aht20_profGet(AHT20_Prof_T _Phase)
+{
+    return &aht20_Profile[_Phase];
+};
+#else
+    #define __AHT20_PROF_START()
+    #define __AHT20_PROF_MARK(_Phase)
+    #define __AHT20_PROF_MEASURE(_On)
+    #define __AHT20_PROF_MARK_MEASURE(_Phase)
+#endif
+
+
+/* ============================================================================
+ *                       CRC-8 CHECK
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief CRC-8 over a buffer (AHT20: poly 0x31, init 0xFF, no reflection)
+ * @retval 0x00 when the buffer includes a matching CRC byte
+ * @note __AHT20_LITE uses a short bitwise loop instead of
+ *       the generic err.h implementation
+ * ------------------------------------------------------- */
+static uint8_t aht20_CRC8(const uint8_t* _Buf, uint8_t _Len)
+{
+#if __AHT20_LITE
+    uint8_t _Crc = 0xFF;                                   /**< Initial CRC value: 0xFF */
+
+    while(_Len--)
+    {
+        _Crc ^= *_Buf++;
+        for(uint8_t _Bit = 0; _Bit < 8; _Bit++)
+        {
+            _Crc = (_Crc & 0x80) ? (uint8_t)((_Crc << 1) ^ 0x31) : (uint8_t)(_Crc << 1);  /**< Polynomial: x^8 + x^5 + x^4 + 1 */
+        };
+    };
+
+    return _Crc;
+#else
+    /* CRC-8 configuration for AHT20 (per datasheet), static: no per-call setup */
+    static hcrc8_T crc8_aht20 = 
+    {
+        .Poly = 0x31,                                      /**< Polynomial: x^8 + x^5 + x^4 + 1 (0x31 = 0b00110001) */
+        .Init = 0xFF,                                      /**< Initial CRC value: 0xFF */
+        .refIn = false,                                    /**< No input bit reflection */
+        .refOut = false,                                   /**< No output bit reflection */
+        .xorOut = 0x00                                     /**< No final XOR operation */
+    };
+
+    return CRC8_Calc(&crc8_aht20, _Buf, _Len);
+#endif
+};
+
+
+/* ============================================================================
+ *                       SAMPLE TIMING
+ * ============================================================================ */
+#if __AHT20_TIMING
+static AHT20_Timing_T _aht20_Timing;                       /**< Timing of the measurement in progress / last one */
+
+/* -------------------------------------------------------
+ * @brief Milliseconds since trigger, saturated to 8 bits
+ * ------------------------------------------------------- */
+static uint8_t aht20_sinceTrigger(void)
+{
+    uint16_t _Elapsed = __AHT20_TIMESTAMP() - _aht20_Timing.Trigger;  /**< Unsigned subtraction handles tick wrap */
+    return (_Elapsed > 0xFF) ? 0xFF : (uint8_t)_Elapsed;
+};
+
+/* -------------------------------------------------------
+ * @brief Timing of the last measurement
+ * ------------------------------------------------------- */
+const AHT20_Timing_T* aht20_getTiming(void)
+{
+    return &_aht20_Timing;
+};
+#endif
+
+
+/* ============================================================================
+ *                       LAST SAMPLE CACHE
+ * ============================================================================ */
+#if __AHT20_CACHE
+static uint8_t      _aht20_LastPacked[__AHT20_PACKED_SIZE];  /**< Data bytes of the last valid frame */
+static AHT20_Data_T _aht20_Last;                           /**< Converted copy, Timing/Seq set on arrival */
+static bool         _aht20_LastValid = false;              /**< A valid frame was received */
+static bool         _aht20_LastStale = false;              /**< _aht20_Last needs conversion */
+
+/* -------------------------------------------------------
+ * @brief Last valid sample in physical units
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_getLast(AHT20_Data_T* _Data)
+{
+    if(!_aht20_LastValid)
+    {
+        return AHT20_Res_ERR;
+    };
+
+    if(_aht20_LastStale)                                   /**< Convert once per new frame */
+    {
+        aht20_Unpack(_aht20_LastPacked, &_aht20_Last);
+        _aht20_LastStale = false;
+    };
+
+    *_Data = _aht20_Last;
+    return AHT20_Res_OK;
+};
+#endif
+
+
+/* ============================================================================
+ *                       USER CALIBRATION
+ * ============================================================================ */
+#if __AHT20_CALIB
+static AHT20_Calib_T _aht20_Calib =                        /**< Active correction, identity by default */
+{
+    .TempOffset = 0,
+    .HumiOffset = 0,
+    .TempGain = __AHT20_CALIB_GAIN_ONE,
+    .HumiGain = __AHT20_CALIB_GAIN_ONE
+};
+
+/* -------------------------------------------------------
+ * @brief Set the correction used by aht20_Unpack()
+ * ------------------------------------------------------- */
+void aht20_setCalib(const AHT20_Calib_T* _Calib)
+{
+    _aht20_Calib = *_Calib;
+#if __AHT20_CACHE
+    _aht20_LastStale = true;                               /**< Cached value used the old coefficients */
+#endif
+};
+
+#if __AHT20_LITE
+/* -------------------------------------------------------
+ * @brief Apply gain/offset in 32 bits and limit to the sensor range
+ * @param _Value: Value in 0.01 units
+ * @param _Gain: Q14 gain
+ * @param _Offset: Offset in 0.01 units
+ * @param _Min: Lowest result (0.01 units)
+ * @param _Max: Highest result (0.01 units)
+ * @note A negative offset near 0%RH or a gain above 1.0 near the range
+ *       end must not wrap around in the 16-bit result
+ * ------------------------------------------------------- */
+static int32_t aht20_calibApply(int32_t _Value, uint16_t _Gain, int16_t _Offset, int32_t _Min, int32_t _Max)
+{
+    int32_t _Result = ((_Value * _Gain) >> 14) + _Offset;
+
+    if(_Result < _Min)
+    {
+        return _Min;
+    };
+    if(_Result > _Max)
+    {
+        return _Max;
+    };
+    return _Result;
+};
+#endif
+#endif
+
+
+/* ============================================================================
+ *                       SEQUENCE NUMBERS
+ * ============================================================================ */
+#if __AHT20_SEQUENCE
+static uint16_t _aht20_Seq = 0;                            /**< Sequence number of the last trigger */
+
+/* -------------------------------------------------------
+ * @brief Sequence number of the last triggered measurement
+ * ------------------------------------------------------- */
+uint16_t aht20_getSeq(void)
+{
+    return _aht20_Seq;
+};
+
+/* -------------------------------------------------------
+ * @brief Check a received sequence number (receiver side)
+ * @note Distance is evaluated as signed 16-bit so wrap-around works:
+ *       0 → in order, > 0 → samples were lost, < 0 → duplicate/late.
+ *       Seen keeps one bit per number of the last 32, so a late sample
+ *       is told apart from a duplicate.
+ *       The window starts full, so a number just below the first one
+ *       received never takes back a gap that was not counted.
+ * ------------------------------------------------------- */
+bool aht20_seqCheck(AHT20_SeqTrack_T* _Track, uint16_t _Seq)
+{
+    int16_t  _Dist = (int16_t)(_Seq - _Track->Next);
+    uint16_t _Back;                                        /**< Position behind the newest number (0 = Next - 1) */
+
+    if(!_Track->Started)                                   /**< First sample defines the start point */
+    {
+        _Track->Started = true;
+        _Track->Seen = 0xFFFFFFFFUL;                       /**< Nothing before it is expected: older numbers are duplicates, not gaps */
+        _Dist = 0;
+    };
+
+    if(_Dist >= 0)                                         /**< New: in order or after a gap */
+    {
+        _Track->Gaps += (uint16_t)_Dist;                   /**< Missing samples in between */
+        _Track->Seen = ((uint16_t)_Dist < 31) ? (_Track->Seen << (_Dist + 1)) | 1 : 1;
+        _Track->Next = _Seq + 1;
+        return true;
+    };
+
+    _Back = (uint16_t)(-1 - _Dist);
+    if(_Back >= 32)                                        /**< Too old to tell: reject */
+    {
+        _Track->Late++;
+        return false;
+    };
+
+    if(_Track->Seen & ((uint32_t)1 << _Back))              /**< Already received */
+    {
+        _Track->Dups++;
+        return false;
+    };
+
+    _Track->Seen |= (uint32_t)1 << _Back;                  /**< Late arrival fills its gap */
+    _Track->Gaps--;
+    return true;
+};
+#endif
 
 
 /* ============================================================================
@@ -65,7 +359,7 @@
  * @brief Initialize AHT20 sensor with calibration check
  * @retval AHT20_Res_T: Initialization status
  *         - AHT20_Res_OK: Sensor initialized and calibrated successfully
- *         - AHT20_Res_ERR: Initialization failed, sensor not calibrated
+ *         - AHT20_Res_ERR: Initialization failed, sensor not calibrated or bus transfer failed
  * @note Initialization sequence (per AHT20 datasheet):
  *       1. Wait 40ms after power-on for sensor stabilization
  *       2. Send soft reset command (0xBA) to reset sensor
@@ -79,33 +373,51 @@
 AHT20_Res_T aht20_Init(void)
 {
     /* AHT20 command definitions */
-    uint8_t _AHT20_CMD_Init[3] = {0xBE, 0x08, 0x00};       /**< Initialization/calibration command sequence */
-    uint8_t _AHT20_CMD_Reset[1] = {0xBA};                  /**< Soft reset command */
-    uint8_t _AHT20_CMD_Status[1] = {0x71};                 /**< Status register read command */
+    uint8_t _AHT20_CMD_Init[3] = {__AHT20_CMD_INIT, __AHT20_CMD_INIT_P1, __AHT20_CMD_INIT_P2}; /**< Initialization/calibration command sequence */
+    uint8_t _AHT20_CMD_Reset[1] = {__AHT20_CMD_RESET};     /**< Soft reset command */
+    uint8_t _AHT20_CMD_Status[1] = {__AHT20_CMD_STATUS};   /**< Status register read command */
     uint8_t _Status = 0x00;                                /**< Status register value storage */
+    __AHT20_PROF_START();
     
     /* Wait for sensor power-on stabilization */
     delay_ms(__AHT20_AFTER_POWER_ON_DELAY);                /**< 40ms delay for sensor internal initialization */
+    __AHT20_PROF_MARK(AHT20_Prof_InitPowerOn);
     
     /* Perform soft reset to ensure clean state */
-    i2c_writeAddress(__AHT20_Add, _AHT20_CMD_Reset, 1);    /**< Send reset command to sensor */
+    if(!__AHT20_I2C_Write(_AHT20_CMD_Reset, 1))            /**< Send reset command to sensor */
+    {
+        return AHT20_Res_ERR;                              /**< No ACK or bus stuck */
+    };
     delay_ms(__AHT20_AFTER_POWER_ON_DELAY);                /**< Wait 40ms for reset to complete */
+    __AHT20_PROF_MARK(AHT20_Prof_InitReset);
     
     /* Read initial status register */
-    i2c_readSequential(__AHT20_Add, _AHT20_CMD_Status, 1, &_Status, 1);  /**< Send status command and read 1 byte */
+    if(!__AHT20_I2C_Query(_AHT20_CMD_Status, 1, &_Status, 1))  /**< Send status command and read 1 byte */
+    {
+        return AHT20_Res_ERR;
+    };
+    __AHT20_PROF_MARK(AHT20_Prof_InitStatus);
     
     /* Check if sensor needs calibration */
     if(bitCheckLow(_Status, __AHT20_Flag_CAL))             /**< If calibration bit (bit 3) is LOW */
     {
         /* Send calibration command sequence */
-        i2c_writeAddress(__AHT20_Add, _AHT20_CMD_Init, sizeof(_AHT20_CMD_Init));  /**< Write 3-byte init command */
+        if(!__AHT20_I2C_Write(_AHT20_CMD_Init, sizeof(_AHT20_CMD_Init)))  /**< Write 3-byte init command */
+        {
+            return AHT20_Res_ERR;
+        };
     };
     
     /* Wait for calibration to complete */
     delay_ms(__AHT20_DELAY);                               /**< 10ms delay for calibration process */
+    __AHT20_PROF_MARK(AHT20_Prof_InitCalib);
  
     /* Verify calibration success */
-    i2c_readSequential(__AHT20_Add, _AHT20_CMD_Status, 1, &_Status, 1);  /**< Re-read status register */
+    if(!__AHT20_I2C_Query(_AHT20_CMD_Status, 1, &_Status, 1))  /**< Re-read status register */
+    {
+        return AHT20_Res_ERR;
+    };
+    __AHT20_PROF_MARK(AHT20_Prof_InitVerify);
     
     /* Check if calibration was successful */
     if(bitCheckLow(_Status, __AHT20_Flag_CAL))             /**< If calibration bit still LOW */
@@ -118,7 +430,7 @@ AHT20_Res_T aht20_Init(void)
 
 
 /* ============================================================================
- *                       DATA ACQUISITION FUNCTION
+ *                       DATA ACQUISITION FUNCTIONS
  * ============================================================================ */
 
 /* -------------------------------------------------------
@@ -126,73 +438,301 @@ AHT20_Res_T aht20_Init(void)
  * @param _Data: Pointer to AHT20_Data_T structure to store converted values
  * @retval AHT20_Res_T: Measurement status
  *         - AHT20_Res_OK: Data acquired and validated successfully
- *         - AHT20_Res_ERR: Measurement failed (sensor busy, not calibrated, or CRC error)
- * @note Measurement sequence:
- *       1. Send trigger command (0xAC 0x33 0x00)
- *       2. Wait 80ms for sensor to complete measurement
- *       3. Read 7 bytes: [Status | Humi_H | Humi_M | Humi_L/Temp_H | Temp_M | Temp_L | CRC]
- *       4. Validate status flags (BUSY=0, CAL=1)
- *       5. Validate CRC-8 checksum
- *       6. Extract and convert 20-bit raw values to physical units
- * @note Data format in response bytes:
- *       Humidity: Bits [Byte1:Byte2:Byte3[7:4]] = 20-bit value
- *       Temperature: Bits [Byte3[3:0]:Byte4:Byte5] = 20-bit value
+ *         - AHT20_Res_ERR: Measurement failed (not calibrated, CRC error or bus transfer failed)
+ *         - AHT20_Res_TimeOut: Sensor still busy after the measurement delay
+ * @note Blocking wrapper: aht20_Trigger() → wait 80ms → aht20_readData()
  * ------------------------------------------------------- */
 AHT20_Res_T aht20_getData(AHT20_Data_T* _Data)
 {
-    uint32_t _Temp_I = 0x0;                                /**< Temporary storage for raw temperature value */
-    uint32_t _Humi_I = 0x0;                                /**< Temporary storage for raw humidity value */
-    
-    /* AHT20 measurement trigger command */
-    uint8_t _AHT20_CMD_Trigger[3] = {0xAC, 0x33, 0x00};    /**< Trigger measurement command sequence */
-    
-    /* Buffer for sensor response (7 bytes total) */
-    uint8_t _rxBuffer[7] = {0};                            /**< [Status, Humi[19:12], Humi[11:4], Humi[3:0]+Temp[19:16], Temp[15:8], Temp[7:0], CRC] */
-    
-    /* CRC-8 configuration for AHT20 (per datasheet) */
-    hcrc8_T crc8_aht20 = 
+    AHT20_Res_T _Res;                                      /**< Result of the frame read */
+    __AHT20_PROF_START();
+
+    /* Trigger measurement */
+    if(aht20_Trigger() != AHT20_Res_OK)                    /**< Send 3-byte trigger command */
     {
-        .Poly = 0x31,                                      /**< Polynomial: x^8 + x^5 + x^4 + 1 (0x31 = 0b00110001) */
-        .Init = 0xFF,                                      /**< Initial CRC value: 0xFF */
-        .refIn = false,                                    /**< No input bit reflection */
-        .refOut = false,                                   /**< No output bit reflection */
-        .xorOut = 0x00                                     /**< No final XOR operation */
+        return AHT20_Res_ERR;
     };
-    
-    /* Trigger measurement */
-    i2c_writeAddress(__AHT20_Add, _AHT20_CMD_Trigger, 3);  /**< Send 3-byte trigger command */
+    __AHT20_PROF_MARK(AHT20_Prof_Trigger);
     delay_ms(__AHT20_MEASURE_DELAY);                       /**< Wait 80ms for measurement to complete */
+    __AHT20_PROF_MARK(AHT20_Prof_Wait);
+
+    /* Read, validate and convert measurement result */
+    _Res = aht20_readData(_Data);
+    if(_Res == AHT20_Res_Busy)                             /**< Still busy after the full measurement time */
+    {
+        return AHT20_Res_TimeOut;
+    };
+
+    return _Res;
+};
+
+/* -------------------------------------------------------
+ * @brief Start a measurement without waiting for the result
+ * @retval AHT20_Res_T: AHT20_Res_OK, or AHT20_Res_ERR if the bus transfer failed
+ * @note Sends trigger command (0xAC 0x33 0x00); result is ready ~80ms later
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_Trigger(void)
+{
+    /* AHT20 measurement trigger command */
+    uint8_t _AHT20_CMD_Trigger[3] = {__AHT20_CMD_TRIGGER, __AHT20_CMD_TRIGGER_P1, __AHT20_CMD_TRIGGER_P2}; /**< Trigger measurement command sequence */
+
+    bool _Sent = __AHT20_I2C_Write(_AHT20_CMD_Trigger, 3);  /**< Send 3-byte trigger command */
+
+#if __AHT20_SEQUENCE
+    _aht20_Seq++;                                          /**< New measurement, new number (a failed trigger leaves a gap) */
+#endif
+#if __AHT20_TIMING
+    _aht20_Timing.Trigger = __AHT20_TIMESTAMP();           /**< Conversion starts now */
+    _aht20_Timing.Ready = 0xFF;
+    _aht20_Timing.Frame = 0xFF;
+#endif
+    return _Sent ? AHT20_Res_OK : AHT20_Res_ERR;
+};
+
+/* -------------------------------------------------------
+ * @brief Read and validate a finished measurement as packed bytes
+ * @param _Packed: Pointer to 5-byte buffer for the data bytes
+ * @retval AHT20_Res_T: Measurement status
+ *         - AHT20_Res_OK: Frame valid, _Packed filled
+ *         - AHT20_Res_Busy: Sensor still converting (BUSY=1)
+ *         - AHT20_Res_ERR: Not calibrated (CAL=0), CRC error or bus transfer failed
+ * @note Read sequence:
+ *       1. Read 7 bytes: [Status | Humi_H | Humi_M | Humi_L/Temp_H | Temp_M | Temp_L | CRC]
+ *       2. Validate status flags (BUSY=0, CAL=1)
+ *       3. Validate CRC-8 checksum
+ *       4. Copy the 5 data bytes to _Packed
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_readPacked(uint8_t* _Packed)
+{
+    /* Buffer for sensor response (7 bytes total) */
+    uint8_t _rxBuffer[__AHT20_FRAME_SIZE] = {0};           /**< [Status, Humi[19:12], Humi[11:4], Humi[3:0]+Temp[19:16], Temp[15:8], Temp[7:0], CRC] */
+    __AHT20_PROF_START();
+#if __AHT20_TIMING
+    uint8_t _Ready = aht20_sinceTrigger();                 /**< Read start: if BUSY is clear, data was ready by now */
+#endif
     
     /* Read measurement result */
-    i2c_readAdress(__AHT20_Add, _rxBuffer, 7);             /**< Read 7 bytes (status + 5 data + CRC) */
+    if(!__AHT20_I2C_Read(_rxBuffer, __AHT20_FRAME_SIZE))   /**< Read 7 bytes (status + 5 data + CRC) */
+    {
+        return AHT20_Res_ERR;                              /**< No ACK or bus stuck: 0xFF status would look BUSY */
+    };
+    __AHT20_PROF_MARK(AHT20_Prof_Read);
     
     /* Validate status flags */
-    if((bitCheckHigh(_rxBuffer[0], __AHT20_Flag_BUSY)) || (bitCheckLow(_rxBuffer[0], __AHT20_Flag_CAL)))  /**< Check if busy (bit7=1) or not calibrated (bit3=0) */
+    if(bitCheckHigh(_rxBuffer[0], __AHT20_Flag_BUSY))      /**< Check if busy (bit7=1) */
+    {
+        return AHT20_Res_Busy;                             /**< Measurement not finished yet */
+    };
+#if __AHT20_TIMING
+    if(_aht20_Timing.Ready == 0xFF)                        /**< First read that found BUSY cleared */
+    {
+        _aht20_Timing.Ready = _Ready;
+    };
+#endif
+    
+    if(bitCheckLow(_rxBuffer[0], __AHT20_Flag_CAL))        /**< Check if not calibrated (bit3=0) */
     {
         return AHT20_Res_ERR;                              /**< Sensor not ready or measurement failed */
     };
+    __AHT20_PROF_MARK(AHT20_Prof_Status);
     
     /* Validate CRC-8 checksum */
-    if(CRC8_Calc(&crc8_aht20, _rxBuffer, sizeof(_rxBuffer)) != 0x00)  /**< CRC calculation on all 7 bytes should equal 0x00 */
+    if(aht20_CRC8(_rxBuffer, sizeof(_rxBuffer)) != 0x00)   /**< CRC calculation on all 7 bytes should equal 0x00 */
     {
         return AHT20_Res_ERR;                              /**< CRC validation failed - data corrupted */
     };
+    __AHT20_PROF_MARK(AHT20_Prof_CRC);
+    
+    /* Hand out the 5 data bytes (status and CRC are not needed any more) */
+    for(uint8_t _Idx = 0; _Idx < __AHT20_PACKED_SIZE; _Idx++)
+    {
+        _Packed[_Idx] = _rxBuffer[_Idx + 1];
+    };
+#if __AHT20_TIMING
+    _aht20_Timing.Frame = aht20_sinceTrigger();            /**< Valid frame available */
+#endif
+#if __AHT20_CACHE
+    for(uint8_t _Idx = 0; _Idx < __AHT20_PACKED_SIZE; _Idx++)
+    {
+        _aht20_LastPacked[_Idx] = _Packed[_Idx];
+    };
+#if __AHT20_TIMING
+    _aht20_Last.Timing = _aht20_Timing;
+#endif
+#if __AHT20_SEQUENCE
+    _aht20_Last.Seq = _aht20_Seq;
+#endif
+    _aht20_LastValid = true;
+    _aht20_LastStale = true;                               /**< Converted on demand by aht20_getLast() */
+#endif
+    
+    return AHT20_Res_OK;                                   /**< Frame valid */
+};
+
+/* -------------------------------------------------------
+ * @brief Read and validate a finished measurement in physical units
+ * @param _Data: Pointer to AHT20_Data_T structure to store converted values
+ * @retval AHT20_Res_T: Same codes as aht20_readPacked()
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_readData(AHT20_Data_T* _Data)
+{
+    uint8_t _Packed[__AHT20_PACKED_SIZE];                  /**< Validated data bytes */
+    AHT20_Res_T _Res = aht20_readPacked(_Packed);
+
+    if(_Res != AHT20_Res_OK)
+    {
+        return _Res;
+    };
+
+    __AHT20_PROF_MEASURE(true);                            /**< Only this call feeds Prof_Extract/Prof_Convert */
+    aht20_Unpack(_Packed, _Data);
+    __AHT20_PROF_MEASURE(false);
+#if __AHT20_TIMING
+    _Data->Timing = _aht20_Timing;                         /**< Attach acquisition timing to the sample */
+#endif
+#if __AHT20_SEQUENCE
+    _Data->Seq = _aht20_Seq;                               /**< Attach sequence number to the sample */
+#endif
+#if __AHT20_CACHE
+    _aht20_Last = *_Data;                                  /**< Already converted: aht20_getLast() just copies */
+    _aht20_LastStale = false;
+#endif
+    return AHT20_Res_OK;                                   /**< Measurement successful - data valid */
+};
+
+
+/* ============================================================================
+ *                       DATA CONVERSION FUNCTION
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Extract the 20-bit raw values from 5 packed data bytes
+ * @note Declared in aht20_internal.h, aht20_sub.c uses it too
+ * ------------------------------------------------------- */
+void aht20_rawExtract(const uint8_t* _Packed, uint32_t* _Humi, uint32_t* _Temp)
+{
+    /* ===== Extract TEMPERATURE data ===== */
+    /* Temperature bits: Byte2[3:0] (MSB) + Byte3[7:0] + Byte4[7:0] (LSB) = 20 bits */
+    *_Temp = ((uint32_t) _Packed[4] + ((uint32_t)_Packed[3] << 8) + ((uint32_t)_Packed[2] << 16));  /**< Combine bytes into 32-bit value */
+    *_Temp &= 0x000FFFFF;                                  /**< Mask to keep only lower 20 bits (ignore humidity bits) */
     
-    /* ===== Extract and convert TEMPERATURE data ===== */
-    /* Temperature bits: Byte3[3:0] (MSB) + Byte4[7:0] + Byte5[7:0] (LSB) = 20 bits */
-    _Temp_I = ((uint32_t) _rxBuffer[5] + ((uint32_t)_rxBuffer[4] << 8) + ((uint32_t)_rxBuffer[3] << 16));  /**< Combine bytes into 32-bit value */
-    _Temp_I &= 0x000FFFFF;                                 /**< Mask to keep only lower 20 bits (ignore humidity bits) */
+    /* ===== Extract HUMIDITY data ===== */
+    /* Humidity bits: Byte0[7:0] (MSB) + Byte1[7:0] + Byte2[7:4] (LSB) = 20 bits */
+    *_Humi = ((uint32_t) _Packed[0] << 16) + ((uint32_t) _Packed[1] << 8)  + ((uint32_t) _Packed[2]);  /**< Combine bytes into 32-bit value */
+    *_Humi = *_Humi >> 4;                                  /**< Shift right by 4 bits to extract upper 20 bits (remove temperature bits) */
+};
+
+#if __AHT20_LITE || __AHT20_DECODE
+/* -------------------------------------------------------
+ * @brief Convert 20-bit raw values to 0.01 units (integer, no calibration)
+ * @note Used by the __AHT20_LITE build of aht20_Unpack() and by
+ *       aht20_decodeFrames(), so both give the same numbers
+ * ------------------------------------------------------- */
+static void aht20_rawToUnits(uint32_t _Humi, uint32_t _Temp, uint16_t* _HumiOut, int16_t* _TempOut)
+{
+    /* Convert to 0.01°C: (Raw × 20000 / 2^20) - 5000 = (Raw × 625 / 2^15) - 5000 */
+    *_TempOut = (int16_t)((_Temp * 625UL) >> 15) - 5000;   /**< Max 2^20 × 625 fits in 32 bits */
+    
+    /* Convert to 0.01%: Raw × 10000 / 2^20 = Raw × 625 / 2^16 */
+    *_HumiOut = (uint16_t)((_Humi * 625UL) >> 16);
+};
+#endif
+
+/* -------------------------------------------------------
+ * @brief Convert a packed sample to temperature and humidity
+ * @param _Packed: Pointer to 5 data bytes [Humi_H | Humi_M | Humi_L/Temp_H | Temp_M | Temp_L]
+ * @param _Data: Pointer to AHT20_Data_T structure to store converted values
+ * @note Data format in packed bytes:
+ *       Humidity: Bits [Byte0:Byte1:Byte2[7:4]] = 20-bit value
+ *       Temperature: Bits [Byte2[3:0]:Byte3:Byte4] = 20-bit value
+ * ------------------------------------------------------- */
+void aht20_Unpack(const uint8_t* _Packed, AHT20_Data_T* _Data)
+{
+    uint32_t _Temp_I = 0x0;                                /**< Temporary storage for raw temperature value */
+    uint32_t _Humi_I = 0x0;                                /**< Temporary storage for raw humidity value */
+    __AHT20_PROF_START();
     
+    aht20_rawExtract(_Packed, &_Humi_I, &_Temp_I);         /**< 20-bit raw humidity and temperature */
+    __AHT20_PROF_MARK_MEASURE(AHT20_Prof_Extract);
+    
+#if __AHT20_LITE
+    aht20_rawToUnits(_Humi_I, _Temp_I, &_Data->Humidity, &_Data->Temp);  /**< 0.01%RH / 0.01°C */
+#else
     /* Convert to Celsius: (Raw × 200 / 2^20) - 50 */
     _Data->Temp = ((_Temp_I * __AHT20_Temp_factor) - __AHT20_Temp_const);  /**< Apply scaling factor and offset */
     
-    /* ===== Extract and convert HUMIDITY data ===== */
-    /* Humidity bits: Byte1[7:0] (MSB) + Byte2[7:0] + Byte3[7:4] (LSB) = 20 bits */
-    _Humi_I = ((uint32_t) _rxBuffer[1] << 16) + ((uint32_t) _rxBuffer[2] << 8)  + ((uint32_t) _rxBuffer[3]);  /**< Combine bytes into 32-bit value */
-    _Humi_I = _Humi_I >> 4;                                /**< Shift right by 4 bits to extract upper 20 bits (remove temperature bits) */
-    
     /* Convert to percentage: Raw × 100 / 2^20 */
     _Data->Humidity = _Humi_I * __AHT20_Humi_factor;       /**< Apply scaling factor */
-    
-    return AHT20_Res_OK;                                   /**< Measurement successful - data valid */
-};
\ No newline at end of file
+#endif
+
+#if __AHT20_CALIB
+    /* ===== Apply user correction: Value × Gain / 2^14 + Offset ===== */
+#if __AHT20_LITE
+    _Data->Temp = (int16_t)aht20_calibApply(_Data->Temp, _aht20_Calib.TempGain, _aht20_Calib.TempOffset, -5000, 15000);  /**< -50.00..150.00°C */
+    _Data->Humidity = (uint16_t)aht20_calibApply(_Data->Humidity, _aht20_Calib.HumiGain, _aht20_Calib.HumiOffset, 0, 10000);  /**< 0.00..100.00%RH */
+#else
+    _Data->Temp = (_Data->Temp * _aht20_Calib.TempGain) / __AHT20_CALIB_GAIN_ONE + _aht20_Calib.TempOffset * 0.01f;
+    _Data->Humidity = (_Data->Humidity * _aht20_Calib.HumiGain) / __AHT20_CALIB_GAIN_ONE + _aht20_Calib.HumiOffset * 0.01f;
+#endif
+#endif
+    __AHT20_PROF_MARK_MEASURE(AHT20_Prof_Convert);
+};
+
+
+/* ============================================================================
+ *                       FRAME DECODE FUNCTIONS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Check status flags and CRC-8 of one 7-byte frame
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_checkFrame(const uint8_t* _Frame)
+{
+    if(bitCheckHigh(_Frame[0], __AHT20_Flag_BUSY))
+    {
+        return AHT20_Res_Busy;
+    };
+
+    if(bitCheckLow(_Frame[0], __AHT20_Flag_CAL) || (aht20_CRC8(_Frame, __AHT20_FRAME_SIZE) != 0x00))
+    {
+        return AHT20_Res_ERR;
+    };
+
+    return AHT20_Res_OK;
+};
+
+#if __AHT20_DECODE
+/* -------------------------------------------------------
+ * @brief Validate and convert a block of captured 7-byte frames
+ * @note Column output: one tight loop per block instead of one
+ *       AHT20_Data_T and one float conversion per frame
+ * ------------------------------------------------------- */
+uint8_t aht20_decodeFrames(const uint8_t* _Frames, uint8_t _Count, int16_t* _Temp, uint16_t* _Humi, AHT20_Res_T* _Res)
+{
+    uint8_t _Valid = 0;
+
+    for(uint8_t _Idx = 0; _Idx < _Count; _Idx++, _Frames += __AHT20_FRAME_SIZE)
+    {
+        AHT20_Res_T _State = aht20_checkFrame(_Frames);
+        uint32_t    _Humi_I, _Temp_I;                      /**< 20-bit raw values */
+
+        if(_Res != NULL)
+        {
+            _Res[_Idx] = _State;
+        };
+
+        if(_State != AHT20_Res_OK)
+        {
+            _Temp[_Idx] = 0;
+            _Humi[_Idx] = 0;
+            continue;
+        };
+
+        aht20_rawExtract(_Frames + 1, &_Humi_I, &_Temp_I);  /**< Data bytes follow the status byte */
+        aht20_rawToUnits(_Humi_I, _Temp_I, &_Humi[_Idx], &_Temp[_Idx]);
+        _Valid++;
+    };
+
+    return _Valid;
+};
+#endif
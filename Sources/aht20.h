@@ -10,8 +10,20 @@
  *           temperature and humidity sensor with I2C communication.
  * 
  * @note     FUNCTION SUMMARY:
- *           - aht20_Init    : Initialize AHT20 sensor with calibration check and soft reset
- *           - aht20_getData : Trigger measurement and read temperature/humidity values
+ *           - aht20_Init       : Initialize AHT20 sensor with calibration check and soft reset
+ *           - aht20_getData    : Trigger measurement and read temperature/humidity values
+ *           - aht20_Trigger    : Start a measurement without waiting for it (non-blocking)
+ *           - aht20_readPacked : Read and validate a finished measurement as 5 packed bytes
+ *           - aht20_readData   : Read and validate a finished measurement in physical units
+ *           - aht20_Unpack     : Convert 5 packed bytes (e.g. from a log) to physical units
+ *           - aht20_getLast    : Last valid sample without bus access (only with __AHT20_CACHE = 1)
+ *           - aht20_checkFrame   : Validate flags and CRC of one captured 7-byte frame
+ *           - aht20_decodeFrames : Validate and convert captured 7-byte frames in bulk (only with __AHT20_DECODE = 1)
+ *           - aht20_getTiming  : Trigger/ready/frame times of the last sample (only with __AHT20_TIMING = 1)
+ *           - aht20_setCalib   : Gain/offset correction applied on conversion (only with __AHT20_CALIB = 1)
+ *           - aht20_getSeq     : Sequence number of the last trigger (only with __AHT20_SEQUENCE = 1)
+ *           - aht20_seqCheck   : Receiver side duplicate rejection and gap counting (only with __AHT20_SEQUENCE = 1)
+ *           - aht20_prof*      : Timer1 phase profiler (only with __AHT20_PROFILE = 1)
  * 
  * @note     Sensor Specifications:
  *           - Temperature range: -40°C to +85°C (±0.3°C accuracy)
@@ -105,6 +117,62 @@
 #define __AHT20_Add       0x38           /**< AHT20 fixed I2C 7-bit address (no alternative address available) */
 
 
+/* ============================================================================
+ *                         AHT20 COMMANDS
+ * ============================================================================ */
+#define __AHT20_CMD_INIT       0xBE      /**< Initialization/calibration command */
+#define __AHT20_CMD_INIT_P1    0x08      /**< Initialization parameter 1 */
+#define __AHT20_CMD_INIT_P2    0x00      /**< Initialization parameter 2 */
+#define __AHT20_CMD_TRIGGER    0xAC      /**< Trigger measurement command */
+#define __AHT20_CMD_TRIGGER_P1 0x33      /**< Trigger parameter 1 */
+#define __AHT20_CMD_TRIGGER_P2 0x00      /**< Trigger parameter 2 */
+#define __AHT20_CMD_RESET      0xBA      /**< Soft reset command */
+#define __AHT20_CMD_STATUS     0x71      /**< Status register read command */
+
+
+/* ============================================================================
+ *                         I2C BUS BACKEND
+ * ============================================================================ */
+#define __AHT20_BUS_TWI   0              /**< Hardware TWI through i2c.h (ATmega) */
+#define __AHT20_BUS_USI   1              /**< USI two-wire mode through aht20_usi.h (ATtiny) */
+
+#ifndef __AHT20_BUS
+    #define __AHT20_BUS   __AHT20_BUS_TWI  /**< Selected bus backend */
+#endif
+
+/**< Each macro yields true when the transfer completed (ACK, no bus timeout) */
+#if __AHT20_BUS == __AHT20_BUS_USI
+    #include "aht20_usi.h"
+    #define __AHT20_I2C_Write(_Buf, _Len)                aht20_usiWrite(__AHT20_Add, _Buf, _Len)
+    #define __AHT20_I2C_Read(_Buf, _Len)                 aht20_usiRead(__AHT20_Add, _Buf, _Len)
+    #define __AHT20_I2C_Query(_Cmd, _CmdLen, _Buf, _Len) aht20_usiReadSequential(__AHT20_Add, _Cmd, _CmdLen, _Buf, _Len)
+#else
+    /**< i2c.h reports no bus status: TWI transfers count as done, a missing sensor shows up as CAL/CRC error */
+    #define __AHT20_I2C_Write(_Buf, _Len)                (i2c_writeAddress(__AHT20_Add, _Buf, _Len), true)
+    #define __AHT20_I2C_Read(_Buf, _Len)                 (i2c_readAdress(__AHT20_Add, _Buf, _Len), true)
+    #define __AHT20_I2C_Query(_Cmd, _CmdLen, _Buf, _Len) (i2c_readSequential(__AHT20_Add, _Cmd, _CmdLen, _Buf, _Len), true)
+#endif
+
+
+/* ============================================================================
+ *                         STRIPPED CONFIGURATION (OPTIONAL)
+ * ============================================================================ */
+#ifndef __AHT20_LITE
+    #define __AHT20_LITE  0              /**< 1: integer results (0.01 units) and built-in CRC, no float / err.h code */
+#endif
+
+
+/* ============================================================================
+ *                         AHT20 FRAME SIZES
+ * ============================================================================ */
+#define __AHT20_FRAME_SIZE  7            /**< Measurement response length: status + 5 data bytes + CRC */
+#define __AHT20_PACKED_SIZE 5            /**< Packed sample length: the 5 data bytes (20-bit humidity + 20-bit temperature) */
+
+/**< Upper 16 of the 20 raw bits straight from packed bytes (for compares and statistics without conversion) */
+#define __AHT20_HUMI16(_Packed) (((uint16_t)(_Packed)[0] << 8) | (_Packed)[1])                                          /**< 0..65535 = 0..100%RH */
+#define __AHT20_TEMP16(_Packed) (((uint16_t)((_Packed)[2] & 0x0F) << 12) | ((uint16_t)(_Packed)[3] << 4) | ((_Packed)[4] >> 4))  /**< 0..65535 = -50..150°C */
+
+
 /* ============================================================================
  *                         AHT20 STATUS FLAGS
  * ============================================================================ */
@@ -120,6 +188,61 @@
 #define __AHT20_MEASURE_DELAY        80  /**< Measurement duration in milliseconds (typical 75-80ms) */
 
 
+/* ============================================================================
+ *                         PHASE PROFILER (OPTIONAL)
+ * ============================================================================ */
+#ifndef __AHT20_PROFILE
+    #define __AHT20_PROFILE     0        /**< 1: measure driver phases with Timer1, 0: macros compile to nothing */
+#endif
+#ifndef __AHT20_PROFILE_CLK
+    #define __AHT20_PROFILE_CLK ((1 << CS11) | (1 << CS10))  /**< Timer1 clock select: clk/64 (4us/tick @16MHz, 262ms range) */
+#endif
+
+
+/* ============================================================================
+ *                         SAMPLE TIMING (OPTIONAL)
+ * ============================================================================ */
+#ifndef __AHT20_TIMING
+    #define __AHT20_TIMING      0        /**< 1: record trigger/ready/frame times with every sample */
+#endif
+#if __AHT20_TIMING && !defined(__AHT20_TIMESTAMP)
+    #error "__AHT20_TIMING requires __AHT20_TIMESTAMP() returning a uint16_t millisecond tick (e.g. #define __AHT20_TIMESTAMP() ((uint16_t)millis()))"
+#endif
+
+
+/* ============================================================================
+ *                         SAMPLE SEQUENCE NUMBER (OPTIONAL)
+ * ============================================================================ */
+#ifndef __AHT20_SEQUENCE
+    #define __AHT20_SEQUENCE    0        /**< 1: number every triggered measurement (16-bit, wraps) */
+#endif
+
+
+/* ============================================================================
+ *                         BULK FRAME DECODE (OPTIONAL)
+ * ============================================================================ */
+#ifndef __AHT20_DECODE
+    #define __AHT20_DECODE      0        /**< 1: build aht20_decodeFrames() for captured frame blocks */
+#endif
+
+
+/* ============================================================================
+ *                         LAST SAMPLE CACHE (OPTIONAL)
+ * ============================================================================ */
+#ifndef __AHT20_CACHE
+    #define __AHT20_CACHE       0        /**< 1: keep the last valid sample for aht20_getLast() */
+#endif
+
+
+/* ============================================================================
+ *                         USER CALIBRATION (OPTIONAL)
+ * ============================================================================ */
+#ifndef __AHT20_CALIB
+    #define __AHT20_CALIB       0        /**< 1: apply gain/offset correction in aht20_Unpack() */
+#endif
+#define __AHT20_CALIB_GAIN_ONE  16384    /**< Gain 1.0 in Q14 fixed point */
+
+
 /* ============================================================================
  *                         AHT20 CONVERSION FACTORS
  * ============================================================================ */
@@ -159,19 +282,106 @@ typedef enum
 {
     AHT20_Res_OK,                        /**< Operation completed successfully */
     AHT20_Res_ERR,                       /**< General error (calibration failed, sensor not responding) */
-    AHT20_Res_TimeOut                    /**< Timeout error (sensor busy too long, no response) */
+    AHT20_Res_TimeOut,                   /**< Timeout error (sensor busy too long, no response) */
+    AHT20_Res_Busy                       /**< Measurement still in progress (BUSY flag set), read again later */
 } AHT20_Res_T;
 
+/* -------------------------------------------------------
+ * @brief Acquisition timing of one sample (4 bytes)
+ * @note Ready and Frame are offsets from Trigger in ms, saturated at 255
+ * @note Ready is the start of the first frame read that found BUSY=0,
+ *       so its resolution is the polling interval of aht20_readData()
+ * ------------------------------------------------------- */
+typedef struct
+{
+    uint16_t Trigger;                    /**< __AHT20_TIMESTAMP() when the trigger command was sent */
+    uint8_t  Ready;                      /**< Trigger → BUSY seen cleared (ms) */
+    uint8_t  Frame;                      /**< Trigger → frame read and validated (ms) */
+} AHT20_Timing_T;
+
 /* -------------------------------------------------------
  * @brief AHT20 measurement data structure
  * @note Contains converted temperature and humidity values
  * ------------------------------------------------------- */
 typedef struct 
 {
+#if __AHT20_LITE
+    int16_t  Temp;                       /**< Temperature in 0.01°C (2534 = 25.34°C), range: -4000 to +8500 */
+    uint16_t Humidity;                   /**< Relative humidity in 0.01% (4512 = 45.12%), range: 0 to 10000 */
+#else
     float Temp;                          /**< Temperature in degrees Celsius (°C), range: -40 to +85 */
     float Humidity;                      /**< Relative humidity in percentage (%), range: 0 to 100 */
+#endif
+#if __AHT20_TIMING
+    AHT20_Timing_T Timing;               /**< Acquisition timing, filled by aht20_readData()/aht20_getData() */
+#endif
+#if __AHT20_SEQUENCE
+    uint16_t Seq;                        /**< Sequence number of the trigger this sample belongs to */
+#endif
 } AHT20_Data_T;
 
+/* -------------------------------------------------------
+ * @brief Linear correction: Value = Value × Gain / 16384 + Offset
+ * @note Integer fields so the same record works with __AHT20_LITE
+ * ------------------------------------------------------- */
+typedef struct
+{
+    int16_t  TempOffset;                 /**< Temperature offset in 0.01°C */
+    int16_t  HumiOffset;                 /**< Humidity offset in 0.01%RH */
+    uint16_t TempGain;                   /**< Temperature gain, Q14 (__AHT20_CALIB_GAIN_ONE = 1.0) */
+    uint16_t HumiGain;                   /**< Humidity gain, Q14 (__AHT20_CALIB_GAIN_ONE = 1.0) */
+} AHT20_Calib_T;
+
+#if __AHT20_SEQUENCE
+/* -------------------------------------------------------
+ * @brief Receiver side sequence tracker
+ * @note One per sensor; see aht20_seqCheck()
+ * ------------------------------------------------------- */
+typedef struct
+{
+    uint16_t Next;                       /**< Expected next sequence number */
+    uint16_t Gaps;                       /**< Samples still missing (late arrivals are taken back out) */
+    uint16_t Dups;                       /**< Duplicates rejected (already received) */
+    uint16_t Late;                       /**< Rejected as older than the 32 sample window */
+    uint32_t Seen;                       /**< Bit n: sequence number Next - 1 - n received */
+    bool     Started;                    /**< First sample received */
+} AHT20_SeqTrack_T;
+#endif
+
+
+/* -------------------------------------------------------
+ * @brief Driver phases measured by the profiler
+ * @note Each phase is the time between two consecutive boundaries
+ * ------------------------------------------------------- */
+typedef enum
+{
+    AHT20_Prof_Trigger,                  /**< Trigger command write (0xAC 0x33 0x00) */
+    AHT20_Prof_Wait,                     /**< Measurement delay in aht20_getData() */
+    AHT20_Prof_Read,                     /**< 7-byte frame read */
+    AHT20_Prof_Status,                   /**< BUSY/CAL flag check */
+    AHT20_Prof_CRC,                      /**< CRC-8 validation */
+    AHT20_Prof_Extract,                  /**< 20-bit raw value extraction (aht20_readData() only) */
+    AHT20_Prof_Convert,                  /**< Conversion to °C and %RH (aht20_readData() only) */
+    AHT20_Prof_InitPowerOn,              /**< aht20_Init(): power-on delay */
+    AHT20_Prof_InitReset,                /**< aht20_Init(): soft reset + delay */
+    AHT20_Prof_InitStatus,               /**< aht20_Init(): first status read */
+    AHT20_Prof_InitCalib,                /**< aht20_Init(): calibration command + delay */
+    AHT20_Prof_InitVerify,               /**< aht20_Init(): status re-read */
+    AHT20_Prof_Count                     /**< Number of phases (array size) */
+} AHT20_Prof_T;
+
+/* -------------------------------------------------------
+ * @brief Accumulated statistics of one phase
+ * @note Values are Timer1 ticks (see __AHT20_PROFILE_CLK)
+ * ------------------------------------------------------- */
+typedef struct
+{
+    uint16_t Min;                        /**< Shortest duration seen */
+    uint16_t Max;                        /**< Longest duration seen */
+    uint32_t Sum;                        /**< Sum of all durations (average = Sum / Count) */
+    uint16_t Count;                      /**< Number of measurements */
+} AHT20_ProfStat_T;
+
 
 /* ============================================================================
  *                         FUNCTION PROTOTYPES
@@ -181,7 +391,7 @@ typedef struct
  * @brief Initialize AHT20 sensor with calibration check
  * @retval AHT20_Res_T: Status code
  *         - AHT20_Res_OK: Initialization successful, sensor ready
- *         - AHT20_Res_ERR: Initialization failed, sensor not calibrated
+ *         - AHT20_Res_ERR: Initialization failed, sensor not calibrated or bus transfer failed
  * @note Initialization sequence:
  *       1. Wait 40ms for power-on stabilization
  *       2. Read status register
@@ -209,4 +419,148 @@ AHT20_Res_T aht20_Init(void);
  * ------------------------------------------------------- */
 AHT20_Res_T aht20_getData(AHT20_Data_T* _Data);
 
+/* -------------------------------------------------------
+ * @brief Start a measurement without waiting for the result
+ * @note Sends the trigger command (0xAC 0x33 0x00) and returns immediately.
+ *       The sensor converts for ~80ms; the CPU is free for other work
+ *       (e.g. aht20_logService()) until aht20_readPacked()/aht20_readData().
+ * @retval AHT20_Res_T: Status code
+ *         - AHT20_Res_OK: Command sent
+ *         - AHT20_Res_ERR: Bus transfer failed (NACK or clock stretch timeout)
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_Trigger(void);
+
+/* -------------------------------------------------------
+ * @brief Read a finished measurement as 5 packed data bytes
+ * @param _Packed: Pointer to a __AHT20_PACKED_SIZE byte buffer
+ * @retval AHT20_Res_T: Status code
+ *         - AHT20_Res_OK: Frame valid, _Packed holds [Humi[19:12], Humi[11:4], Humi[3:0]+Temp[19:16], Temp[15:8], Temp[7:0]]
+ *         - AHT20_Res_Busy: Conversion not finished yet, _Packed untouched
+ *         - AHT20_Res_ERR: Sensor not calibrated, CRC error or bus transfer failed
+ * @note The packed form is the most compact lossless sample (40 bits),
+ *       suited for logging. Convert later with aht20_Unpack().
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_readPacked(uint8_t* _Packed);
+
+/* -------------------------------------------------------
+ * @brief Read a finished measurement in physical units
+ * @param _Data: Pointer to AHT20_Data_T structure to store results
+ * @retval AHT20_Res_T: Same codes as aht20_readPacked()
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_readData(AHT20_Data_T* _Data);
+
+/* -------------------------------------------------------
+ * @brief Convert a packed sample to temperature and humidity
+ * @param _Packed: Pointer to __AHT20_PACKED_SIZE bytes from aht20_readPacked()
+ * @param _Data: Pointer to AHT20_Data_T structure to store results
+ * ------------------------------------------------------- */
+void aht20_Unpack(const uint8_t* _Packed, AHT20_Data_T* _Data);
+
+/* -------------------------------------------------------
+ * @brief Check status flags and CRC-8 of one captured 7-byte frame
+ * @param _Frame: __AHT20_FRAME_SIZE bytes (status, 5 data bytes, CRC)
+ * @retval AHT20_Res_T: Same codes as aht20_readPacked(); the packed
+ *         sample is _Frame + 1 when the result is AHT20_Res_OK
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_checkFrame(const uint8_t* _Frame);
+
+#if __AHT20_DECODE
+/* -------------------------------------------------------
+ * @brief Validate and convert a block of captured 7-byte frames
+ * @param _Frames: _Count frames of __AHT20_FRAME_SIZE bytes back to back
+ *                 (status, 5 data bytes, CRC, e.g. from a bus capture)
+ * @param _Count: Number of frames
+ * @param _Temp: Temperature column in 0.01°C (0 for invalid frames)
+ * @param _Humi: Humidity column in 0.01%RH (0 for invalid frames)
+ * @param _Res: Per-frame status (OK / Busy / ERR), NULL if not wanted
+ * @retval Number of valid frames
+ * @note Same checks as aht20_readPacked() (BUSY, CAL, CRC-8) but no bus
+ *       access, and integer conversion without calibration, so it runs
+ *       unchanged on a host compiler as well.
+ * ------------------------------------------------------- */
+uint8_t aht20_decodeFrames(const uint8_t* _Frames, uint8_t _Count, int16_t* _Temp, uint16_t* _Humi, AHT20_Res_T* _Res);
+#endif
+
+#if __AHT20_TIMING
+/* -------------------------------------------------------
+ * @brief Timing of the last measurement
+ * @retval Pointer to the timing record (for aht20_readPacked() users)
+ * @note Valid after aht20_readPacked() returned AHT20_Res_OK
+ * ------------------------------------------------------- */
+const AHT20_Timing_T* aht20_getTiming(void);
+#endif
+
+#if __AHT20_CACHE
+/* -------------------------------------------------------
+ * @brief Last valid sample in physical units, without bus access
+ * @param _Data: Pointer to AHT20_Data_T structure to store results
+ * @retval AHT20_Res_T: Status code
+ *         - AHT20_Res_OK: _Data holds the last valid sample
+ *         - AHT20_Res_ERR: No valid sample read yet
+ * @note The sample is converted once, on the first call after a new
+ *       frame (or after aht20_setCalib()); later calls copy the cached
+ *       result. Several consumers can poll it at any rate.
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_getLast(AHT20_Data_T* _Data);
+#endif
+
+#if __AHT20_CALIB
+/* -------------------------------------------------------
+ * @brief Set the correction used by aht20_Unpack() from now on
+ * @param _Calib: New coefficients (copied)
+ * @note Logged samples are raw, so re-reading them through
+ *       aht20_Unpack() applies the new coefficients to old data too
+ * ------------------------------------------------------- */
+void aht20_setCalib(const AHT20_Calib_T* _Calib);
+#endif
+
+#if __AHT20_SEQUENCE
+/* -------------------------------------------------------
+ * @brief Sequence number of the last triggered measurement
+ * @note Incremented by every aht20_Trigger(): a failed or skipped
+ *       measurement leaves a gap the receiver can count
+ * ------------------------------------------------------- */
+uint16_t aht20_getSeq(void);
+
+/* -------------------------------------------------------
+ * @brief Check a received sequence number (receiver side)
+ * @param _Track: Tracker of the sending sensor
+ * @param _Seq: Received sequence number
+ * @retval true: New sample: in order, after a gap (gap is counted) or a
+ *               late one filling a gap of the last 32 numbers (gap is
+ *               taken back)
+ *         false: Duplicate (Dups) or older than the window (Late), drop it
+ * @note Comparison is wrap-safe: numbers up to 32767 ahead are "new"
+ * @note Late samples are accepted out of order; the receiver sorts by
+ *       sequence number if it needs them in order
+ * ------------------------------------------------------- */
+bool aht20_seqCheck(AHT20_SeqTrack_T* _Track, uint16_t _Seq);
+#endif
+
+#if __AHT20_PROFILE
+/* -------------------------------------------------------
+ * @brief Per-phase statistics, indexed by AHT20_Prof_T
+ * @note Global symbol so simulators (simavr, debugger) can read it directly
+ * ------------------------------------------------------- */
+extern AHT20_ProfStat_T aht20_Profile[AHT20_Prof_Count];
+
+/* -------------------------------------------------------
+ * @brief Start Timer1 free-running and clear statistics
+ * @note Timer1 must not be used by the application while profiling
+ * ------------------------------------------------------- */
+void aht20_profInit(void);
+
+/* -------------------------------------------------------
+ * @brief Clear all phase statistics
+ * ------------------------------------------------------- */
+void aht20_profReset(void);
+
+/* -------------------------------------------------------
+ * @brief Get statistics of one phase
+ * @param _Phase: Phase index
+ * @retval Pointer to the phase statistics (e.g. to send over UART)
+ * ------------------------------------------------------- */
+const AHT20_ProfStat_T* aht20_profGet(AHT20_Prof_T _Phase);
+#endif
+
 #endif /* _aht20_H_ */
\ No newline at end of file
@@ -0,0 +1,338 @@
+/**
+ ******************************************************************************
+ * @file     aht20_fifo.c
+ * @brief    Lock-free sample queue implementation
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     EXECUTION FLOW:
+ *           1. Push (producer):
+ *              └─> Read Tail → Full (Head - Tail == size)? → Drop
+ *                  → Copy sample to Buf[Head & mask] → Barrier → Head++ (publish)
+ *
+ *           2. Pop (consumer):
+ *              └─> Read Head → Empty (Head == Tail)? → Return false
+ *                  → Copy Buf[Tail & mask] → Barrier → Tail++ (release slot)
+ *
+ *           3. Zero-copy variants:
+ *              └─> Reserve/Commit and Peek/Release are the two halves of
+ *                  Push and Pop; the caller reads or writes the slot itself
+ *
+ *           4. Fan-out (one producer, several consumers):
+ *              └─> Push: Copy sample to Buf[Head & mask] → Barrier → Head++
+ *                  (no Tail to check, the oldest slot is overwritten)
+ *              └─> Peek: Head - Tail >= size? → Lost += skipped → Tail = Head - size + 1
+ *                  → Return Buf[Tail & mask]
+ *              └─> Release: Barrier → Head - Tail >= size? (slot rewritten
+ *                  during the read) → Discard : Accept → Tail++
+ *
+ *           5. Filtered batch (per consumer):
+ *              └─> Pop next sample → Since < MinGap? → Drop
+ *                  → Humi and Temp inside dead-band of the last delivered one? → Drop
+ *                  → Append to caller buffer, remember values, Since = 0 → Repeat until empty or full
+ *
+ * @note     No interrupt locking is needed: a side only ever reads the other
+ *           side's index, and a stale value only makes the queue look
+ *           fuller (producer) or emptier (consumer) than it is.
+ *
+ * @note     For detailed documentation with examples, visit:
+ *           https://github.com/aKaReZa75/AVR_AHT20
+ ******************************************************************************
+ */
+
+#include "aht20_fifo.h"
+
+
+/* -------------------------------------------------------
+ * @brief Empty the queue
+ * ------------------------------------------------------- */
+void aht20_fifoInit(AHT20_Fifo_T* _Fifo)
+{
+    _Fifo->Head = 0;
+    _Fifo->Tail = 0;
+};
+
+/* -------------------------------------------------------
+ * @brief Get the next free slot to write in place (producer side only)
+ * ------------------------------------------------------- */
+uint8_t* aht20_fifoReserve(AHT20_Fifo_T* _Fifo)
+{
+    uint8_t _Head = _Fifo->Head;                           /**< Own index: no race */
+
+    if((uint8_t)(_Head - _Fifo->Tail) >= __AHT20_FIFO_SIZE)  /**< All slots in use */
+    {
+        return NULL;
+    };
+
+    return _Fifo->Buf[_Head & __AHT20_FIFO_MASK];
+};
+
+/* -------------------------------------------------------
+ * @brief Publish the reserved slot
+ * ------------------------------------------------------- */
+void aht20_fifoCommit(AHT20_Fifo_T* _Fifo)
+{
+    __AHT20_BARRIER();                                     /**< Slot written before it becomes visible */
+    _Fifo->Head = _Fifo->Head + 1;                         /**< Single byte store: atomic publish */
+};
+
+/* -------------------------------------------------------
+ * @brief View the oldest sample in place (consumer side only)
+ * ------------------------------------------------------- */
+const uint8_t* aht20_fifoPeek(const AHT20_Fifo_T* _Fifo)
+{
+    uint8_t _Tail = _Fifo->Tail;                           /**< Own index: no race */
+
+    if(_Tail == _Fifo->Head)                               /**< Nothing published */
+    {
+        return NULL;
+    };
+
+    __AHT20_BARRIER();                                     /**< Read slot only after seeing Head */
+    return _Fifo->Buf[_Tail & __AHT20_FIFO_MASK];
+};
+
+/* -------------------------------------------------------
+ * @brief Hand the peeked slot back to the producer
+ * ------------------------------------------------------- */
+void aht20_fifoRelease(AHT20_Fifo_T* _Fifo)
+{
+    __AHT20_BARRIER();                                     /**< Slot consumed before it is handed back */
+    _Fifo->Tail = _Fifo->Tail + 1;
+};
+
+/* -------------------------------------------------------
+ * @brief Add one packed sample (producer side only)
+ * ------------------------------------------------------- */
+bool aht20_fifoPush(AHT20_Fifo_T* _Fifo, const uint8_t* _Packed)
+{
+    uint8_t* _Slot = aht20_fifoReserve(_Fifo);
+
+    if(_Slot == NULL)
+    {
+        return false;
+    };
+
+    for(uint8_t _Idx = 0; _Idx < __AHT20_PACKED_SIZE; _Idx++)
+    {
+        _Slot[_Idx] = _Packed[_Idx];
+    };
+    aht20_fifoCommit(_Fifo);
+
+    return true;
+};
+
+/* -------------------------------------------------------
+ * @brief Take the oldest packed sample (consumer side only)
+ * ------------------------------------------------------- */
+bool aht20_fifoPop(AHT20_Fifo_T* _Fifo, uint8_t* _Packed)
+{
+    const uint8_t* _Slot = aht20_fifoPeek(_Fifo);
+
+    if(_Slot == NULL)
+    {
+        return false;
+    };
+
+    for(uint8_t _Idx = 0; _Idx < __AHT20_PACKED_SIZE; _Idx++)
+    {
+        _Packed[_Idx] = _Slot[_Idx];
+    };
+    aht20_fifoRelease(_Fifo);
+
+    return true;
+};
+
+/* -------------------------------------------------------
+ * @brief Number of queued samples
+ * ------------------------------------------------------- */
+uint8_t aht20_fifoCount(const AHT20_Fifo_T* _Fifo)
+{
+    return (uint8_t)(_Fifo->Head - _Fifo->Tail);
+};
+
+/* -------------------------------------------------------
+ * @brief Empty the fan-out ring
+ * ------------------------------------------------------- */
+void aht20_fanoutInit(AHT20_Fanout_T* _Ring)
+{
+    _Ring->Head = 0;
+};
+
+/* -------------------------------------------------------
+ * @brief Attach a consumer at the current write position
+ * ------------------------------------------------------- */
+void aht20_fanoutJoin(const AHT20_Fanout_T* _Ring, AHT20_Reader_T* _Reader)
+{
+    _Reader->Tail = _Ring->Head;
+    _Reader->Lost = 0;
+};
+
+/* -------------------------------------------------------
+ * @brief Get the producer slot to write in place
+ * ------------------------------------------------------- */
+uint8_t* aht20_fanoutReserve(AHT20_Fanout_T* _Ring)
+{
+    return _Ring->Buf[_Ring->Head & __AHT20_FIFO_MASK];
+};
+
+/* -------------------------------------------------------
+ * @brief Publish the reserved slot to all consumers
+ * ------------------------------------------------------- */
+void aht20_fanoutCommit(AHT20_Fanout_T* _Ring)
+{
+    __AHT20_BARRIER();                                     /**< Slot written before it becomes visible */
+    _Ring->Head = _Ring->Head + 1;
+};
+
+/* -------------------------------------------------------
+ * @brief Add one packed sample for all consumers
+ * ------------------------------------------------------- */
+void aht20_fanoutPush(AHT20_Fanout_T* _Ring, const uint8_t* _Packed)
+{
+    uint8_t* _Slot = aht20_fanoutReserve(_Ring);
+
+    for(uint8_t _Idx = 0; _Idx < __AHT20_PACKED_SIZE; _Idx++)
+    {
+        _Slot[_Idx] = _Packed[_Idx];
+    };
+    aht20_fanoutCommit(_Ring);
+};
+
+/* -------------------------------------------------------
+ * @brief View the oldest unread sample of one consumer in place
+ * @note Head runs freely over 0..255, so a consumer must look at the
+ *       ring at least every 256 - __AHT20_FIFO_SIZE samples for the lag
+ *       to be measured correctly
+ * ------------------------------------------------------- */
+const uint8_t* aht20_fanoutPeek(const AHT20_Fanout_T* _Ring, AHT20_Reader_T* _Reader)
+{
+    uint8_t _Head = _Ring->Head;
+    uint8_t _Lag  = _Head - _Reader->Tail;                 /**< Published, not yet read */
+
+    if(_Lag == 0)
+    {
+        return NULL;
+    };
+
+    if(_Lag >= __AHT20_FIFO_SIZE)                          /**< Oldest unread slots already reused */
+    {
+        _Reader->Lost += _Lag - (__AHT20_FIFO_SIZE - 1);
+        _Reader->Tail = _Head - (__AHT20_FIFO_SIZE - 1);
+    };
+
+    __AHT20_BARRIER();                                     /**< Read slot only after seeing Head */
+    return _Ring->Buf[_Reader->Tail & __AHT20_FIFO_MASK];
+};
+
+/* -------------------------------------------------------
+ * @brief Finish reading the peeked slot
+ * ------------------------------------------------------- */
+bool aht20_fanoutRelease(const AHT20_Fanout_T* _Ring, AHT20_Reader_T* _Reader)
+{
+    bool _Intact;
+
+    __AHT20_BARRIER();                                     /**< Slot consumed before Head is checked again */
+    _Intact = ((uint8_t)(_Ring->Head - _Reader->Tail) < __AHT20_FIFO_SIZE);  /**< Producer has not reached the slot */
+    if(!_Intact)
+    {
+        _Reader->Lost++;
+    };
+    _Reader->Tail++;
+
+    return _Intact;
+};
+
+/* -------------------------------------------------------
+ * @brief Copy the oldest unread sample of one consumer
+ * ------------------------------------------------------- */
+bool aht20_fanoutPop(const AHT20_Fanout_T* _Ring, AHT20_Reader_T* _Reader, uint8_t* _Packed)
+{
+    const uint8_t* _Slot;
+
+    do
+    {
+        _Slot = aht20_fanoutPeek(_Ring, _Reader);
+        if(_Slot == NULL)
+        {
+            return false;
+        };
+
+        for(uint8_t _Idx = 0; _Idx < __AHT20_PACKED_SIZE; _Idx++)
+        {
+            _Packed[_Idx] = _Slot[_Idx];
+        };
+    } while(!aht20_fanoutRelease(_Ring, _Reader));
+
+    return true;
+};
+
+/* -------------------------------------------------------
+ * @brief Set up a delivery filter
+ * @note Bands converted once to Raw16: humidity × 65536 / 10000,
+ *       temperature × 65536 / 20000
+ * ------------------------------------------------------- */
+void aht20_filterInit(AHT20_Filter_T* _Filter, uint16_t _HumiBand, uint16_t _TempBand, uint8_t _MinGap)
+{
+    uint32_t _Humi = ((uint32_t)_HumiBand * 4096) / 625;
+    uint32_t _Temp = ((uint32_t)_TempBand * 2048) / 625;
+
+    _Filter->HumiBand = (_Humi > 0xFFFF) ? 0xFFFF : (uint16_t)_Humi;
+    _Filter->TempBand = (_Temp > 0xFFFF) ? 0xFFFF : (uint16_t)_Temp;
+    _Filter->MinGap = _MinGap;
+    _Filter->Since = 0xFF;                                 /**< First sample passes */
+};
+
+/* -------------------------------------------------------
+ * @brief Decide whether one sample is delivered
+ * ------------------------------------------------------- */
+static bool aht20_filterPass(AHT20_Filter_T* _Filter, const uint8_t* _Packed)
+{
+    uint16_t _Humi = __AHT20_HUMI16(_Packed);
+    uint16_t _Temp = __AHT20_TEMP16(_Packed);
+
+    if(_Filter->Since != 0xFF)                             /**< Something delivered before */
+    {
+        uint16_t _HumiMove = (_Humi > _Filter->HumiLast) ? (_Humi - _Filter->HumiLast) : (_Filter->HumiLast - _Humi);
+        uint16_t _TempMove = (_Temp > _Filter->TempLast) ? (_Temp - _Filter->TempLast) : (_Filter->TempLast - _Temp);
+
+        if(_Filter->Since < _Filter->MinGap)               /**< Rate limit */
+        {
+            _Filter->Since++;
+            return false;
+        };
+        if((_HumiMove <= _Filter->HumiBand) && (_TempMove <= _Filter->TempBand))  /**< Inside dead-band */
+        {
+            if(_Filter->Since < 0xFE)
+            {
+                _Filter->Since++;
+            };
+            return false;
+        };
+    };
+
+    _Filter->HumiLast = _Humi;
+    _Filter->TempLast = _Temp;
+    _Filter->Since = 0;
+    return true;
+};
+
+/* -------------------------------------------------------
+ * @brief Copy all unread samples that pass a filter, back to back
+ * ------------------------------------------------------- */
+uint8_t aht20_fanoutPopBatch(const AHT20_Fanout_T* _Ring, AHT20_Reader_T* _Reader, AHT20_Filter_T* _Filter, uint8_t* _Packed, uint8_t _Max)
+{
+    uint8_t _Count = 0;
+
+    while((_Count < _Max) && aht20_fanoutPop(_Ring, _Reader, _Packed))
+    {
+        if((_Filter == NULL) || aht20_filterPass(_Filter, _Packed))
+        {
+            _Packed += __AHT20_PACKED_SIZE;                /**< Keep it, next sample after it */
+            _Count++;
+        };
+    };
+
+    return _Count;
+};
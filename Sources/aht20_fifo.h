@@ -0,0 +1,265 @@
+/**
+ ******************************************************************************
+ * @file     aht20_fifo.h
+ * @brief    Lock-free sample queue between AHT20 acquisition and consumers
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     Single-producer / single-consumer ring of packed samples
+ *           (5 bytes each, see aht20_readPacked). Producer and consumer may
+ *           run in different contexts (main loop and ISR) without cli()/sei():
+ *           each side writes only its own 8-bit index, and 8-bit loads and
+ *           stores are atomic on AVR.
+ *
+ * @note     FUNCTION SUMMARY:
+ *           - aht20_fifoInit  : Empty the queue
+ *           - aht20_fifoPush  : Producer side, add one packed sample
+ *           - aht20_fifoPop   : Consumer side, take the oldest packed sample
+ *           - aht20_fifoCount : Number of queued samples
+ *           - aht20_fifoReserve / aht20_fifoCommit : Producer writes in place (no copy)
+ *           - aht20_fifoPeek / aht20_fifoRelease   : Consumer reads in place (no copy)
+ *           - aht20_fanoutInit / aht20_fanoutJoin    : One producer, several consumers with own cursors
+ *           - aht20_fanoutPush / aht20_fanoutPeek / aht20_fanoutRelease / aht20_fanoutPop
+ *           - aht20_filterInit / aht20_fanoutPopBatch : Dead-band / rate filtered, batched reads
+ *
+ * @note     Fan-out ring: every consumer sees every sample. The producer
+ *           never waits; a consumer that falls behind by a full ring is
+ *           moved to the oldest valid slot and the skipped samples are
+ *           counted in its Lost field.
+ *
+ * @note     Usage Example:
+ *           AHT20_Fifo_T queue;                        // global
+ *           aht20_fifoInit(&queue);
+ *           // main loop (producer)
+ *           if (aht20_readPacked(packed) == AHT20_Res_OK) aht20_fifoPush(&queue, packed);
+ *           // UART TX complete ISR (consumer)
+ *           if (aht20_fifoPop(&queue, packed)) { ... }
+ *           // zero-copy producer: frame is validated straight into the slot
+ *           uint8_t* slot = aht20_fifoReserve(&queue);
+ *           if (slot && aht20_readPacked(slot) == AHT20_Res_OK) aht20_fifoCommit(&queue);
+ *
+ * @note     For detailed documentation with examples, visit:
+ *           https://github.com/aKaReZa75/AVR_AHT20
+ ******************************************************************************
+ */
+#ifndef _aht20_fifo_H_
+#define _aht20_fifo_H_
+
+#include "aht20.h"
+
+
+/* ============================================================================
+ *                         FIFO CONFIGURATION
+ * ============================================================================ */
+#ifndef __AHT20_FIFO_SIZE
+    #define __AHT20_FIFO_SIZE   8        /**< Number of slots: power of two, 2..128 (RAM = 5 × size + 2 bytes) */
+#endif
+
+#if (__AHT20_FIFO_SIZE < 2) || (__AHT20_FIFO_SIZE > 128) || (__AHT20_FIFO_SIZE & (__AHT20_FIFO_SIZE - 1))
+    #error "__AHT20_FIFO_SIZE must be a power of two between 2 and 128"
+#endif
+
+#define __AHT20_FIFO_MASK       (__AHT20_FIFO_SIZE - 1)  /**< Slot index mask */
+
+/**< Compiler barrier: slot data must be complete before the index is published */
+#define __AHT20_BARRIER()       __asm__ __volatile__("" ::: "memory")
+
+
+/* ============================================================================
+ *                         TYPE DEFINITIONS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Sample queue
+ * @note Head and Tail run freely (0..255); the difference is the fill level
+ * ------------------------------------------------------- */
+typedef struct
+{
+    uint8_t          Buf[__AHT20_FIFO_SIZE][__AHT20_PACKED_SIZE];  /**< Packed sample slots */
+    volatile uint8_t Head;               /**< Next slot to write, changed by producer only */
+    volatile uint8_t Tail;               /**< Next slot to read, changed by consumer only */
+} AHT20_Fifo_T;
+
+/* -------------------------------------------------------
+ * @brief Fan-out ring, one producer and any number of consumers
+ * @note The slot at Head is being written, so SIZE - 1 samples are
+ *       readable at most
+ * ------------------------------------------------------- */
+typedef struct
+{
+    uint8_t          Buf[__AHT20_FIFO_SIZE][__AHT20_PACKED_SIZE];  /**< Packed sample slots */
+    volatile uint8_t Head;               /**< Next slot to write, changed by producer only */
+} AHT20_Fanout_T;
+
+/* -------------------------------------------------------
+ * @brief Cursor of one fan-out consumer (owned by that consumer)
+ * ------------------------------------------------------- */
+typedef struct
+{
+    uint8_t  Tail;                       /**< Next slot to read */
+    uint16_t Lost;                       /**< Samples overwritten before they were read */
+} AHT20_Reader_T;
+
+/* -------------------------------------------------------
+ * @brief Delivery filter of one consumer (owned by that consumer)
+ * @note A sample passes when at least MinGap samples were skipped since
+ *       the last delivered one AND humidity or temperature moved by the
+ *       dead-band since then
+ * ------------------------------------------------------- */
+typedef struct
+{
+    uint16_t HumiBand;                   /**< Humidity dead-band, Raw16 */
+    uint16_t TempBand;                   /**< Temperature dead-band, Raw16 */
+    uint16_t HumiLast;                   /**< Humidity of the last delivered sample, Raw16 */
+    uint16_t TempLast;                   /**< Temperature of the last delivered sample, Raw16 */
+    uint8_t  MinGap;                     /**< Samples to drop after each delivery (rate limit) */
+    uint8_t  Since;                      /**< Samples dropped since the last delivery (0xFF = none yet) */
+} AHT20_Filter_T;
+
+
+/* ============================================================================
+ *                         FUNCTION PROTOTYPES
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Empty the queue
+ * @param _Fifo: Queue to initialize
+ * @note Call before producer and consumer are started
+ * ------------------------------------------------------- */
+void aht20_fifoInit(AHT20_Fifo_T* _Fifo);
+
+/* -------------------------------------------------------
+ * @brief Add one packed sample (producer side only)
+ * @param _Fifo: Queue
+ * @param _Packed: __AHT20_PACKED_SIZE bytes
+ * @retval true: Sample queued, false: Queue full, sample dropped
+ * ------------------------------------------------------- */
+bool aht20_fifoPush(AHT20_Fifo_T* _Fifo, const uint8_t* _Packed);
+
+/* -------------------------------------------------------
+ * @brief Take the oldest packed sample (consumer side only)
+ * @param _Fifo: Queue
+ * @param _Packed: Destination, __AHT20_PACKED_SIZE bytes
+ * @retval true: Sample copied, false: Queue empty
+ * ------------------------------------------------------- */
+bool aht20_fifoPop(AHT20_Fifo_T* _Fifo, uint8_t* _Packed);
+
+/* -------------------------------------------------------
+ * @brief Number of queued samples
+ * @param _Fifo: Queue
+ * ------------------------------------------------------- */
+uint8_t aht20_fifoCount(const AHT20_Fifo_T* _Fifo);
+
+/* -------------------------------------------------------
+ * @brief Get the next free slot to write in place (producer side only)
+ * @param _Fifo: Queue
+ * @retval Pointer to __AHT20_PACKED_SIZE bytes, NULL if the queue is full
+ * @note The slot is not visible to the consumer until aht20_fifoCommit().
+ *       Not committing (e.g. read failed) simply leaves it free.
+ * ------------------------------------------------------- */
+uint8_t* aht20_fifoReserve(AHT20_Fifo_T* _Fifo);
+
+/* -------------------------------------------------------
+ * @brief Publish the slot returned by aht20_fifoReserve()
+ * @param _Fifo: Queue
+ * ------------------------------------------------------- */
+void aht20_fifoCommit(AHT20_Fifo_T* _Fifo);
+
+/* -------------------------------------------------------
+ * @brief View the oldest sample in place (consumer side only)
+ * @param _Fifo: Queue
+ * @retval Pointer to __AHT20_PACKED_SIZE bytes, NULL if the queue is empty
+ * @note The view stays valid until aht20_fifoRelease()
+ * ------------------------------------------------------- */
+const uint8_t* aht20_fifoPeek(const AHT20_Fifo_T* _Fifo);
+
+/* -------------------------------------------------------
+ * @brief Hand the slot returned by aht20_fifoPeek() back to the producer
+ * @param _Fifo: Queue
+ * ------------------------------------------------------- */
+void aht20_fifoRelease(AHT20_Fifo_T* _Fifo);
+
+/* -------------------------------------------------------
+ * @brief Empty the fan-out ring
+ * @param _Ring: Ring to initialize
+ * ------------------------------------------------------- */
+void aht20_fanoutInit(AHT20_Fanout_T* _Ring);
+
+/* -------------------------------------------------------
+ * @brief Attach a consumer; it receives samples pushed from now on
+ * @param _Ring: Ring
+ * @param _Reader: Cursor of the consumer
+ * ------------------------------------------------------- */
+void aht20_fanoutJoin(const AHT20_Fanout_T* _Ring, AHT20_Reader_T* _Reader);
+
+/* -------------------------------------------------------
+ * @brief Add one packed sample for all consumers (producer side only)
+ * @param _Ring: Ring
+ * @param _Packed: __AHT20_PACKED_SIZE bytes
+ * @note Never blocks: the oldest sample is overwritten
+ * ------------------------------------------------------- */
+void aht20_fanoutPush(AHT20_Fanout_T* _Ring, const uint8_t* _Packed);
+
+/* -------------------------------------------------------
+ * @brief Get the producer slot to write in place
+ * @retval Pointer to __AHT20_PACKED_SIZE bytes (always available)
+ * @note Publish with aht20_fanoutCommit(); without it the slot is reused
+ * ------------------------------------------------------- */
+uint8_t* aht20_fanoutReserve(AHT20_Fanout_T* _Ring);
+
+/* -------------------------------------------------------
+ * @brief Publish the slot returned by aht20_fanoutReserve()
+ * ------------------------------------------------------- */
+void aht20_fanoutCommit(AHT20_Fanout_T* _Ring);
+
+/* -------------------------------------------------------
+ * @brief View the oldest unread sample of one consumer in place
+ * @param _Ring: Ring
+ * @param _Reader: Cursor of the consumer
+ * @retval Pointer to __AHT20_PACKED_SIZE bytes, NULL if nothing new
+ * @note A lagging cursor is first moved to the oldest valid slot and
+ *       the skipped samples are added to _Reader->Lost
+ * ------------------------------------------------------- */
+const uint8_t* aht20_fanoutPeek(const AHT20_Fanout_T* _Ring, AHT20_Reader_T* _Reader);
+
+/* -------------------------------------------------------
+ * @brief Finish reading the slot returned by aht20_fanoutPeek()
+ * @retval true: The data read was intact
+ *         false: The producer overwrote the slot meanwhile, discard it
+ *         (counted in _Reader->Lost)
+ * ------------------------------------------------------- */
+bool aht20_fanoutRelease(const AHT20_Fanout_T* _Ring, AHT20_Reader_T* _Reader);
+
+/* -------------------------------------------------------
+ * @brief Copy the oldest unread sample of one consumer
+ * @param _Packed: Destination, __AHT20_PACKED_SIZE bytes
+ * @retval true: Sample copied, false: Nothing new
+ * @note Overwritten samples are skipped and counted in _Reader->Lost
+ * ------------------------------------------------------- */
+bool aht20_fanoutPop(const AHT20_Fanout_T* _Ring, AHT20_Reader_T* _Reader, uint8_t* _Packed);
+
+/* -------------------------------------------------------
+ * @brief Set up a delivery filter
+ * @param _Filter: Filter of one consumer
+ * @param _HumiBand: Humidity dead-band in 0.01%RH (0 = any change)
+ * @param _TempBand: Temperature dead-band in 0.01°C (0 = any change)
+ * @param _MinGap: Samples to drop after each delivery, 0..254 (0 = no rate limit)
+ * @note The first sample always passes
+ * ------------------------------------------------------- */
+void aht20_filterInit(AHT20_Filter_T* _Filter, uint16_t _HumiBand, uint16_t _TempBand, uint8_t _MinGap);
+
+/* -------------------------------------------------------
+ * @brief Copy all unread samples that pass a filter, back to back
+ * @param _Ring: Ring
+ * @param _Reader: Cursor of the consumer
+ * @param _Filter: Delivery filter, NULL = every sample
+ * @param _Packed: Destination, _Max × __AHT20_PACKED_SIZE bytes
+ * @param _Max: Capacity in samples
+ * @retval Number of samples copied (0 = nothing new passed)
+ * @note Meant to be called once per transmit tick: one call, one
+ *       buffer, one send for the consumer, whatever the sample rate
+ * ------------------------------------------------------- */
+uint8_t aht20_fanoutPopBatch(const AHT20_Fanout_T* _Ring, AHT20_Reader_T* _Reader, AHT20_Filter_T* _Filter, uint8_t* _Packed, uint8_t _Max);
+
+#endif /* _aht20_fifo_H_ */
@@ -0,0 +1,37 @@
+/**
+ ******************************************************************************
+ * @file     aht20_internal.h
+ * @brief    Helpers shared between the AHT20 driver modules (not public API)
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     Included by the driver sources only. Applications use aht20.h
+ *           and the module headers; these functions may change without
+ *           notice.
+ *
+ * @note     FUNCTION SUMMARY:
+ *           - aht20_rawExtract : 20-bit raw humidity and temperature from 5 packed bytes
+ ******************************************************************************
+ */
+#ifndef _aht20_internal_H_
+#define _aht20_internal_H_
+
+#include "aht20.h"
+
+
+/* ============================================================================
+ *                         FUNCTION PROTOTYPES
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Extract the 20-bit raw values from 5 packed data bytes
+ * @param _Packed: __AHT20_PACKED_SIZE bytes [Humi_H | Humi_M | Humi_L/Temp_H | Temp_M | Temp_L]
+ * @param _Humi: 20-bit raw humidity
+ * @param _Temp: 20-bit raw temperature
+ * @note Single place of the bit layout for aht20_Unpack(),
+ *       aht20_decodeFrames() and aht20_subDispatch()
+ * ------------------------------------------------------- */
+void aht20_rawExtract(const uint8_t* _Packed, uint32_t* _Humi, uint32_t* _Temp);
+
+#endif /* _aht20_internal_H_ */
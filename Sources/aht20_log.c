@@ -0,0 +1,631 @@
+/**
+ ******************************************************************************
+ * @file     aht20_log.c
+ * @brief    SPI NOR flash sample log implementation for packed AHT20 samples
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     EXECUTION FLOW:
+ *           1. Append Flow:
+ *              └─> aht20_logAppend() → Copy 5 bytes into RAM page buffer
+ *                  → Page full (50 records) or __AHT20_LOG_FLUSH records pending?
+ *                  → Wait WIP=0 → WREN → Page program of all pending records (group commit,
+ *                    the last one adds lap marker and zone map)
+ *                  → Page full? → Advance write address (wrap → next lap)
+ *                  → Entered new sector? → Mark next sector dirty
+ *
+ *           2. Background Erase Flow:
+ *              └─> aht20_Trigger() → aht20_logService() → Next sector dirty and WIP=0?
+ *                  → WREN → Sector erase (returns at once, chip erases ~45ms)
+ *                  → Sensor converts 80ms in parallel → Erase done before next page program
+ *
+ *           3. Recovery Flow:
+ *              └─> aht20_logInit() → Read last record of each page
+ *                  → First page with empty last record = write position
+ *                  → Lap marker of the page before it = current lap
+ *                  → Replay its flushed records into the RAM buffer and continue after them
+ *                  → Page empty and sector aligned? → Erase it again
+ *                    (a power loss may have interrupted the previous background erase)
+ *
+ * @note     The CPU never waits for an erase in the normal flow: every sector
+ *           holds 16 pages × 50 records = 800 samples, so the erase of the next
+ *           sector has 800 conversion windows to finish. A blocking erase only
+ *           happens if aht20_logService() was never called.
+ *
+ * @note     For detailed documentation with examples, visit:
+ *           https://github.com/aKaReZa75/AVR_AHT20
+ ******************************************************************************
+ */
+
+#include "aht20_log.h"
+
+
+/* ============================================================================
+ *                       MODULE STATE
+ * ============================================================================ */
+static uint8_t  _logPage[__AHT20_LOG_PAGE_SIZE];           /**< RAM page buffer, programmed in one operation when full */
+static uint8_t  _logFill = 0;                              /**< Number of records in _logPage */
+static uint8_t  _logSynced = 0;                            /**< Records of _logPage already programmed to flash */
+static uint32_t _logAddr = 0;                              /**< Offset of the current page inside the log area */
+static bool     _logNextErased = false;                    /**< Sector after the current one is erased (or erasing) */
+static uint8_t  _logLap = 0;                               /**< Ring pass being written (0..254), stored in every full page */
+
+
+/* ============================================================================
+ *                       FLASH ACCESS HELPERS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Select flash and send a command with 24-bit address
+ * @note CS stays LOW; caller transfers data and calls _log_Deselect()
+ * ------------------------------------------------------- */
+static void _log_Command(uint8_t _Cmd, uint32_t _Offset)
+{
+    uint32_t _Flash = __AHT20_LOG_BASE + _Offset;          /**< Absolute flash address */
+
+    bitClear(__AHT20_LOG_CS_PORT, __AHT20_LOG_CS_PIN);     /**< CS LOW: start transaction */
+    spi_Transfer(_Cmd);
+    spi_Transfer((uint8_t)(_Flash >> 16));                 /**< Address MSB first */
+    spi_Transfer((uint8_t)(_Flash >> 8));
+    spi_Transfer((uint8_t)(_Flash));
+};
+
+static void _log_Deselect(void)
+{
+    bitSet(__AHT20_LOG_CS_PORT, __AHT20_LOG_CS_PIN);       /**< CS HIGH: end transaction, chip latches command */
+};
+
+/* -------------------------------------------------------
+ * @brief Check write-in-progress flag (program or erase running)
+ * ------------------------------------------------------- */
+static bool _log_isBusy(void)
+{
+    uint8_t _Status;
+
+    bitClear(__AHT20_LOG_CS_PORT, __AHT20_LOG_CS_PIN);
+    spi_Transfer(__AHT20_LOG_CMD_RDSR);
+    _Status = spi_Transfer(0xFF);
+    _log_Deselect();
+
+    return bitCheckHigh(_Status, __AHT20_LOG_FLAG_WIP);
+};
+
+static void _log_waitIdle(void)
+{
+    while(_log_isBusy());                                  /**< Poll WIP until program/erase finished */
+};
+
+static void _log_writeEnable(void)
+{
+    bitClear(__AHT20_LOG_CS_PORT, __AHT20_LOG_CS_PIN);
+    spi_Transfer(__AHT20_LOG_CMD_WREN);                    /**< Required before every program/erase */
+    _log_Deselect();
+};
+
+/* -------------------------------------------------------
+ * @brief Issue a sector erase without waiting for it
+ * @param _Offset: Any offset inside the sector to erase
+ * ------------------------------------------------------- */
+static void _log_eraseStart(uint32_t _Offset)
+{
+    _log_waitIdle();
+    _log_writeEnable();
+    _log_Command(__AHT20_LOG_CMD_SE, _Offset & ~(__AHT20_LOG_SECTOR_SIZE - 1));
+    _log_Deselect();
+};
+
+/* -------------------------------------------------------
+ * @brief Check whether a record slot is erased (all bytes 0xFF)
+ * @note Humidity and temperature both at full scale is not a valid sample
+ * ------------------------------------------------------- */
+static bool _log_isEmpty(const uint8_t* _Packed)
+{
+    for(uint8_t _Idx = 0; _Idx < __AHT20_PACKED_SIZE; _Idx++)
+    {
+        if(_Packed[_Idx] != 0xFF)
+        {
+            return false;
+        };
+    };
+    return true;
+};
+
+/* -------------------------------------------------------
+ * @brief Read bytes from flash (waits for running program/erase)
+ * ------------------------------------------------------- */
+static void _log_Read(uint32_t _Offset, uint8_t* _Buf, uint16_t _Len)
+{
+    _log_waitIdle();
+    _log_Command(__AHT20_LOG_CMD_READ, _Offset);
+    for(uint16_t _Idx = 0; _Idx < _Len; _Idx++)
+    {
+        _Buf[_Idx] = spi_Transfer(0xFF);
+    };
+    _log_Deselect();
+};
+
+/* -------------------------------------------------------
+ * @brief Read the lap marker of a full page
+ * @retval true: Marker valid, false: erased, partly written or foreign data
+ * ------------------------------------------------------- */
+static bool _log_readLap(uint32_t _Page, uint8_t* _Lap)
+{
+    uint8_t _Marker[__AHT20_LOG_LAP_SIZE];
+
+    _log_Read(_Page + __AHT20_LOG_LAP_ADDR, _Marker, __AHT20_LOG_LAP_SIZE);
+    *_Lap = _Marker[0];
+
+    return (_Marker[0] != 0xFF) && ((uint8_t)(_Marker[0] ^ _Marker[1]) == 0xFF);  /**< Second byte is the complement */
+};
+
+static uint8_t _log_lapNext(uint8_t _Lap)
+{
+    return (_Lap >= 0xFE) ? 0 : _Lap + 1;                  /**< 0xFF stays reserved for erased flash */
+};
+
+static void _log_clearPage(void)
+{
+    for(uint16_t _Idx = 0; _Idx < __AHT20_LOG_PAGE_SIZE; _Idx++)
+    {
+        _logPage[_Idx] = 0xFF;                             /**< Unwritten bytes stay erased in flash */
+    };
+    _logFill = 0;
+    _logSynced = 0;
+};
+
+/* -------------------------------------------------------
+ * @brief Fill the zone map of the full RAM page
+ * @note Min is rounded down and max up to 8 bits (upper byte of Raw16),
+ *       so pruning on them never skips a matching sample
+ * ------------------------------------------------------- */
+static void _log_zoneMap(void)
+{
+    uint16_t _HumiMin = 0xFFFF, _HumiMax = 0, _TempMin = 0xFFFF, _TempMax = 0;
+
+    for(uint8_t _Rec = 0; _Rec < __AHT20_LOG_PAGE_RECS; _Rec++)
+    {
+        const uint8_t* _Packed = &_logPage[_Rec * __AHT20_PACKED_SIZE];
+        uint16_t _Humi = __AHT20_HUMI16(_Packed);
+        uint16_t _Temp = __AHT20_TEMP16(_Packed);
+
+        if(_Humi < _HumiMin) { _HumiMin = _Humi; };
+        if(_Humi > _HumiMax) { _HumiMax = _Humi; };
+        if(_Temp < _TempMin) { _TempMin = _Temp; };
+        if(_Temp > _TempMax) { _TempMax = _Temp; };
+    };
+
+    _logPage[__AHT20_LOG_ZONE_ADDR + 0] = _HumiMin >> 8;
+    _logPage[__AHT20_LOG_ZONE_ADDR + 1] = _HumiMax >> 8;
+    _logPage[__AHT20_LOG_ZONE_ADDR + 2] = _TempMin >> 8;
+    _logPage[__AHT20_LOG_ZONE_ADDR + 3] = _TempMax >> 8;
+};
+
+/* -------------------------------------------------------
+ * @brief Program the not yet synced records of the current page
+ * @note One page program command for all pending records (group
+ *       commit); does not wait for completion
+ * ------------------------------------------------------- */
+static void _log_Program(void)
+{
+    uint16_t _From = _logSynced * __AHT20_PACKED_SIZE;     /**< First byte not in flash yet */
+    uint16_t _To   = _logFill * __AHT20_PACKED_SIZE;       /**< End of buffered records */
+
+    if(_logFill >= __AHT20_LOG_PAGE_RECS)                  /**< Last program of the page: add lap marker and zone map */
+    {
+        _logPage[__AHT20_LOG_LAP_ADDR + 0] = _logLap;
+        _logPage[__AHT20_LOG_LAP_ADDR + 1] = ~_logLap;
+        _log_zoneMap();
+        _To = __AHT20_LOG_PAGE_SIZE;
+    };
+
+    _log_waitIdle();                                       /**< Normally idle: erase finished during conversion */
+    _log_writeEnable();
+    _log_Command(__AHT20_LOG_CMD_PP, _logAddr + _From);
+    for(uint16_t _Idx = _From; _Idx < _To; _Idx++)
+    {
+        spi_Transfer(_logPage[_Idx]);
+    };
+    _log_Deselect();
+
+    _logSynced = _logFill;
+};
+
+/* -------------------------------------------------------
+ * @brief Move to the next page after the current one is full
+ * ------------------------------------------------------- */
+static void _log_nextPage(void)
+{
+    _log_clearPage();
+
+    _logAddr += __AHT20_LOG_PAGE_SIZE;
+    if(_logAddr >= __AHT20_LOG_SIZE)
+    {
+        _logAddr = 0;
+        _logLap = _log_lapNext(_logLap);                   /**< Ring wrapped: older pages now belong to the previous lap */
+    };
+
+    /* Entered a new sector: it must be erased, and the one after becomes the next target */
+    if((_logAddr & (__AHT20_LOG_SECTOR_SIZE - 1)) == 0)
+    {
+        if(!_logNextErased)                                /**< aht20_logService() was not called: erase now */
+        {
+            _log_eraseStart(_logAddr);
+        };
+        _logNextErased = false;
+    };
+};
+
+
+/* ============================================================================
+ *                       PUBLIC FUNCTIONS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Initialize the log and recover the write position
+ * ------------------------------------------------------- */
+void aht20_logInit(void)
+{
+    uint8_t _Rec[__AHT20_PACKED_SIZE];                     /**< Last record of the scanned page */
+    uint8_t _Lap;                                          /**< Lap marker of the page before the write position */
+
+    /* Chip select: output, idle HIGH */
+    bitSet(__AHT20_LOG_CS_PORT, __AHT20_LOG_CS_PIN);
+    bitSet(__AHT20_LOG_CS_DDR, __AHT20_LOG_CS_PIN);
+
+    _log_clearPage();
+    _logNextErased = false;
+    _logLap = 0;
+
+    /* Find first page that is not full: written data is always followed by an erased sector */
+    for(_logAddr = 0; _logAddr < __AHT20_LOG_SIZE; _logAddr += __AHT20_LOG_PAGE_SIZE)
+    {
+        _log_Read(_logAddr + (__AHT20_LOG_PAGE_RECS - 1) * __AHT20_PACKED_SIZE, _Rec, __AHT20_PACKED_SIZE);
+        if(_log_isEmpty(_Rec))
+        {
+            break;
+        };
+    };
+
+    if(_logAddr >= __AHT20_LOG_SIZE)                       /**< No free page at all: restart at the beginning */
+    {
+        _logAddr = 0;
+        _log_eraseStart(_logAddr);
+        return;
+    };
+
+    /* The page before the write position is the newest full one: continue its lap */
+    if(_logAddr == 0)
+    {
+        if(_log_readLap(__AHT20_LOG_SIZE - __AHT20_LOG_PAGE_SIZE, &_Lap))  /**< End of the area written: ring has wrapped */
+        {
+            _logLap = _log_lapNext(_Lap);
+        };
+    }
+    else if(_log_readLap(_logAddr - __AHT20_LOG_PAGE_SIZE, &_Lap))
+    {
+        _logLap = _Lap;
+    };
+
+    /* Replay records flushed to this page before the reset into the RAM buffer */
+    _log_Read(_logAddr, _logPage, __AHT20_LOG_PAGE_RECS * __AHT20_PACKED_SIZE);
+    while((_logFill < __AHT20_LOG_PAGE_RECS) && !_log_isEmpty(&_logPage[_logFill * __AHT20_PACKED_SIZE]))
+    {
+        _logFill++;
+    };
+    _logSynced = _logFill;
+
+    /* An empty sector start may belong to an interrupted erase: erase it again */
+    if((_logFill == 0) && ((_logAddr & (__AHT20_LOG_SECTOR_SIZE - 1)) == 0))
+    {
+        _log_eraseStart(_logAddr);
+    };
+};
+
+/* -------------------------------------------------------
+ * @brief Start erasing the next sector in the background
+ * ------------------------------------------------------- */
+void aht20_logService(void)
+{
+    uint32_t _Next;                                        /**< Offset of the sector after the current one */
+
+    if(_logNextErased || _log_isBusy())                    /**< Nothing to do, or flash still programming */
+    {
+        return;
+    };
+
+    _Next = (_logAddr & ~(__AHT20_LOG_SECTOR_SIZE - 1)) + __AHT20_LOG_SECTOR_SIZE;
+    if(_Next >= __AHT20_LOG_SIZE)                          /**< Ring buffer wrap-around */
+    {
+        _Next = 0;
+    };
+
+    _log_eraseStart(_Next);                                /**< Returns at once, chip erases in parallel */
+    _logNextErased = true;
+};
+
+/* -------------------------------------------------------
+ * @brief Get the next record slot inside the RAM page buffer
+ * ------------------------------------------------------- */
+uint8_t* aht20_logReserve(void)
+{
+    return &_logPage[_logFill * __AHT20_PACKED_SIZE];
+};
+
+/* -------------------------------------------------------
+ * @brief Accept the reserved record, program when due
+ * ------------------------------------------------------- */
+void aht20_logCommit(void)
+{
+    _logFill++;
+
+    if(_logFill >= __AHT20_LOG_PAGE_RECS)                  /**< Page full: program the rest of it and move on */
+    {
+        _log_Program();
+        _log_nextPage();
+        return;
+    };
+
+#if __AHT20_LOG_FLUSH
+    if((uint8_t)(_logFill - _logSynced) >= __AHT20_LOG_FLUSH)  /**< Group commit interval reached */
+    {
+        _log_Program();
+    };
+#endif
+};
+
+/* -------------------------------------------------------
+ * @brief Program all buffered records now
+ * ------------------------------------------------------- */
+void aht20_logFlush(void)
+{
+    if(_logFill > _logSynced)
+    {
+        _log_Program();
+    };
+};
+
+/* -------------------------------------------------------
+ * @brief Append one packed sample to the log
+ * ------------------------------------------------------- */
+void aht20_logAppend(const uint8_t* _Packed)
+{
+    uint8_t* _Slot = aht20_logReserve();
+
+    for(uint8_t _Idx = 0; _Idx < __AHT20_PACKED_SIZE; _Idx++)
+    {
+        _Slot[_Idx] = _Packed[_Idx];
+    };
+
+    aht20_logCommit();
+};
+
+/* -------------------------------------------------------
+ * @brief Index the next appended sample will get
+ * ------------------------------------------------------- */
+uint32_t aht20_logNext(void)
+{
+    return (_logAddr / __AHT20_LOG_PAGE_SIZE) * __AHT20_LOG_PAGE_RECS + _logFill;
+};
+
+/* -------------------------------------------------------
+ * @brief Index of the oldest sample still kept
+ * @note Only sectors ahead of the write position can hold old data; the
+ *       first of them written in the previous lap starts the retained
+ *       range. Erased sectors and leftovers of a chip that never wrapped
+ *       carry no matching lap marker.
+ * ------------------------------------------------------- */
+uint32_t aht20_logOldest(void)
+{
+    uint8_t  _Lap;                                         /**< Lap marker of the sector's first page */
+    uint8_t  _Prev = (_logLap == 0) ? 0xFE : _logLap - 1;  /**< Lap the retained old data was written in */
+    uint32_t _Sector = _logAddr & ~(__AHT20_LOG_SECTOR_SIZE - 1);  /**< Sector being written */
+
+    for(uint8_t _Ahead = 0; _Ahead < 2; _Ahead++)          /**< Next sector may be pre-erased: look one further */
+    {
+        _Sector += __AHT20_LOG_SECTOR_SIZE;
+        if(_Sector >= __AHT20_LOG_SIZE)
+        {
+            _Sector = 0;
+        };
+
+        if(_Sector == (_logAddr & ~(__AHT20_LOG_SECTOR_SIZE - 1)))  /**< Log smaller than 3 sectors */
+        {
+            break;
+        };
+
+        if(_log_readLap(_Sector, &_Lap) && (_Lap == _Prev))  /**< Old data of the previous lap survives here */
+        {
+            return (_Sector / __AHT20_LOG_PAGE_SIZE) * __AHT20_LOG_PAGE_RECS;
+        };
+    };
+
+    return 0;                                              /**< Never wrapped: log starts at record 0 */
+};
+
+/* -------------------------------------------------------
+ * @brief Find the next stored sample above a limit
+ * @note The limit is converted once to Raw16; every record is then
+ *       compared as a 16-bit integer taken directly from its bytes
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_logFindAbove(bool _Temp, int16_t _Limit, uint32_t* _Record, uint32_t _End)
+{
+    uint8_t  _Rec[__AHT20_PACKED_SIZE];                    /**< Record being compared */
+    uint8_t  _Zone[__AHT20_LOG_ZONE_SIZE];                 /**< Zone map of the page */
+    uint32_t _Pos = *_Record;
+    int32_t  _Raw;                                         /**< Limit in Raw16 */
+
+    /* Limit → Raw16: humidity L × 65536 / 10000, temperature (L + 5000) × 65536 / 20000 */
+    _Raw = _Temp ? (((int32_t)_Limit + 5000) * 2048) / 625 : ((int32_t)_Limit * 4096) / 625;
+    if(_Raw < 0)
+    {
+        _Raw = -1;                                         /**< Every sample is above */
+    };
+    if(_Raw > 0xFFFF)
+    {
+        return AHT20_Res_ERR;                              /**< Nothing can be above */
+    };
+
+    while(_Pos != _End)
+    {
+        uint32_t _Page = (_Pos / __AHT20_LOG_PAGE_RECS) * __AHT20_LOG_PAGE_SIZE;
+        uint8_t  _Idx  = _Pos % __AHT20_LOG_PAGE_RECS;
+        bool     _Ram  = (_Page == _logAddr);              /**< Current page lives in RAM */
+        bool     _Skip = false;
+
+        if(!_Ram)                                          /**< Zone map of a full page: 4-byte read */
+        {
+            _log_Read(_Page + __AHT20_LOG_ZONE_ADDR, _Zone, __AHT20_LOG_ZONE_SIZE);
+            _Skip = ((((uint16_t)_Zone[_Temp ? 3 : 1] << 8) | 0xFF) <= _Raw);  /**< Page maximum not above the limit */
+        };
+
+        if(!_Skip)
+        {
+            if(!_Ram)
+            {
+                _log_Command(__AHT20_LOG_CMD_READ, _Page + (uint16_t)_Idx * __AHT20_PACKED_SIZE);  /**< Stream the candidate page */
+            };
+
+            for(; (_Idx < __AHT20_LOG_PAGE_RECS) && (_Pos != _End); _Idx++, _Pos++)
+            {
+                for(uint8_t _Byte = 0; _Byte < __AHT20_PACKED_SIZE; _Byte++)
+                {
+                    _Rec[_Byte] = _Ram ? _logPage[_Idx * __AHT20_PACKED_SIZE + _Byte] : spi_Transfer(0xFF);
+                };
+
+                if(_Ram && (_Idx >= _logFill))             /**< End of buffered records */
+                {
+                    break;
+                };
+
+                if(!_log_isEmpty(_Rec) && ((_Temp ? __AHT20_TEMP16(_Rec) : __AHT20_HUMI16(_Rec)) > _Raw))
+                {
+                    if(!_Ram)
+                    {
+                        _log_Deselect();
+                    };
+                    *_Record = _Pos;
+                    return AHT20_Res_OK;
+                };
+            };
+
+            if(_Ram)                                       /**< Nothing newer than the RAM page */
+            {
+                break;
+            };
+            _log_Deselect();
+        };
+
+        /* Continue at the next page, wrapping at the end of the log area */
+        uint32_t _Next = (_Page / __AHT20_LOG_PAGE_SIZE + 1) * __AHT20_LOG_PAGE_RECS;
+        if((_End >= _Pos) && (_End < _Next))               /**< Range ends inside this page */
+        {
+            break;
+        };
+        _Pos = (_Next >= __AHT20_LOG_RECORDS) ? 0 : _Next;
+    };
+
+    return AHT20_Res_ERR;
+};
+
+/* -------------------------------------------------------
+ * @brief Read back one stored sample
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_logRead(uint32_t _Record, uint8_t* _Packed)
+{
+    uint32_t _Page = (_Record / __AHT20_LOG_PAGE_RECS) * __AHT20_LOG_PAGE_SIZE;
+    uint8_t  _Pos  = _Record % __AHT20_LOG_PAGE_RECS;
+
+    if(_Page >= __AHT20_LOG_SIZE)
+    {
+        return AHT20_Res_ERR;                              /**< Outside the log area */
+    };
+
+    if(_Page == _logAddr)                                  /**< Current page: RAM buffer holds all of its records */
+    {
+        if(_Pos >= _logFill)
+        {
+            return AHT20_Res_ERR;
+        };
+        for(uint8_t _Idx = 0; _Idx < __AHT20_PACKED_SIZE; _Idx++)
+        {
+            _Packed[_Idx] = _logPage[_Pos * __AHT20_PACKED_SIZE + _Idx];
+        };
+        return AHT20_Res_OK;
+    };
+
+    _log_Read(_Page + (uint16_t)_Pos * __AHT20_PACKED_SIZE, _Packed, __AHT20_PACKED_SIZE);
+    if(_log_isEmpty(_Packed))
+    {
+        return AHT20_Res_ERR;                              /**< Erased slot */
+    };
+
+    return AHT20_Res_OK;
+};
+
+/* -------------------------------------------------------
+ * @brief Read a range of samples column by column
+ * @note One READ command per page; the records are split into the
+ *       column arrays while they are clocked in
+ * ------------------------------------------------------- */
+uint8_t aht20_logExport(uint32_t* _Record, uint32_t _End, uint16_t* _Humi, uint16_t* _Temp, uint8_t _Max)
+{
+    uint8_t  _Rec[__AHT20_PACKED_SIZE];                    /**< Record being split */
+    uint32_t _Pos   = *_Record;
+    uint8_t  _Count = 0;
+
+    while((_Pos != _End) && (_Count < _Max))
+    {
+        uint32_t _Page = (_Pos / __AHT20_LOG_PAGE_RECS) * __AHT20_LOG_PAGE_SIZE;
+        uint8_t  _Idx  = _Pos % __AHT20_LOG_PAGE_RECS;
+        bool     _Ram  = (_Page == _logAddr);              /**< Current page lives in RAM */
+
+        if(!_Ram)
+        {
+            _log_waitIdle();
+            _log_Command(__AHT20_LOG_CMD_READ, _Page + (uint16_t)_Idx * __AHT20_PACKED_SIZE);
+        };
+
+        for(; (_Idx < __AHT20_LOG_PAGE_RECS) && (_Pos != _End) && (_Count < _Max); _Idx++, _Pos++)
+        {
+            if(_Ram && (_Idx >= _logFill))                 /**< End of buffered records */
+            {
+                break;
+            };
+
+            for(uint8_t _Byte = 0; _Byte < __AHT20_PACKED_SIZE; _Byte++)
+            {
+                _Rec[_Byte] = _Ram ? _logPage[_Idx * __AHT20_PACKED_SIZE + _Byte] : spi_Transfer(0xFF);
+            };
+
+            if(_log_isEmpty(_Rec))                         /**< Erased slot: not exported */
+            {
+                continue;
+            };
+
+            if(_Humi != NULL)
+            {
+                _Humi[_Count] = __AHT20_HUMI16(_Rec);
+            };
+            if(_Temp != NULL)
+            {
+                _Temp[_Count] = __AHT20_TEMP16(_Rec);
+            };
+            _Count++;
+        };
+
+        if(_Ram)                                           /**< Nothing newer than the RAM page */
+        {
+            break;
+        };
+        _log_Deselect();
+
+        if(_Pos >= __AHT20_LOG_RECORDS)                    /**< Wrap at the end of the log area */
+        {
+            _Pos = 0;
+        };
+    };
+
+    *_Record = _Pos;
+    return _Count;
+};
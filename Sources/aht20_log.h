@@ -0,0 +1,234 @@
+/**
+ ******************************************************************************
+ * @file     aht20_log.h
+ * @brief    SPI NOR flash sample log for packed AHT20 measurements
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     This module stores packed AHT20 samples (5 bytes each, see
+ *           aht20_readPacked) in an external SPI NOR flash (W25Qxx, AT25SF,
+ *           MX25L and other JEDEC compatible parts).
+ *
+ * @note     FUNCTION SUMMARY:
+ *           - aht20_logInit    : Configure CS pin and recover the write position from flash
+ *           - aht20_logService : Start erasing the next sector (call while the sensor converts)
+ *           - aht20_logAppend  : Add one packed sample, program the page when it is full
+ *           - aht20_logRead    : Read back one stored sample by record index
+ *           - aht20_logFlush   : Program buffered samples now (e.g. before sleep or power down)
+ *           - aht20_logOldest / aht20_logNext : Retention window (oldest kept record, next record index)
+ *           - aht20_logFindAbove : Next sample above a limit, skipping pages by their zone map
+ *           - aht20_logExport  : Bulk read of a record range into humidity/temperature columns
+ *           - aht20_logReserve / aht20_logCommit : Write a sample in place into the page buffer
+ *
+ * @note     Storage Layout:
+ *           - Log area: __AHT20_LOG_BASE .. __AHT20_LOG_BASE + __AHT20_LOG_SIZE (ring buffer)
+ *           - Page (256 bytes): 50 records × 5 bytes + 2 byte lap marker + 4 byte zone map
+ *           - Lap marker (bytes 250..251): [Lap, ~Lap], ring pass (0..254) the page
+ *             was written in; tells old data from a chip that never wrapped
+ *           - Zone map (bytes 252..255): [HumiMin, HumiMax, TempMin, TempMax], upper
+ *             8 bits of the page extremes, written with the last page program
+ *           - Empty record: FF FF FF FF FF (erased flash, not a valid sample)
+ *
+ * @note     Timing (typical W25Q80 datasheet values):
+ *           - Page program: 0.7ms typ, 3ms max
+ *           - Sector erase (4KB): 45ms typ, 400ms max
+ *           - AHT20 conversion window: 80ms → one erase fits in one window
+ *
+ * @note     Usage Example:
+ *           uint8_t packed[__AHT20_PACKED_SIZE];
+ *           aht20_logInit();
+ *           while(1) {
+ *               aht20_Trigger();                       // sensor starts converting
+ *               aht20_logService();                    // flash erases next sector meanwhile
+ *               delay_ms(__AHT20_MEASURE_DELAY);
+ *               if (aht20_readPacked(packed) == AHT20_Res_OK) {
+ *                   aht20_logAppend(packed);           // RAM copy, page program every 50 samples
+ *               }
+ *           }
+ *
+ * @note     For detailed documentation with examples, visit:
+ *           https://github.com/aKaReZa75/AVR_AHT20
+ ******************************************************************************
+ */
+#ifndef _aht20_log_H_
+#define _aht20_log_H_
+
+#include "aht20.h"
+
+
+/* ============================================================================
+ *  This module requires the spi.h base library to compile correctly.
+ *  If the file is missing, please download it or contact for support.
+ * ============================================================================ */
+#ifndef _SPI_H_
+    #warning "============================================================"
+    #warning " [WARNING] Missing required dependency: spi.h"
+    #warning "------------------------------------------------------------"
+    #warning "  This module depends on the spi.h base library."
+    #warning "  Please download it from: https://github.com/aKaReZa75/AVR_SPI"
+    #warning "  Or contact for support: akaReza75@gmail.com"
+    #warning "------------------------------------------------------------"
+    #error   "Compilation aborted: Required file 'spi.h' not found!"
+    #warning "============================================================"
+#endif
+
+
+/* ============================================================================
+ *                         FLASH CHIP SELECT PIN
+ * ============================================================================ */
+#ifndef __AHT20_LOG_CS_DDR
+    #define __AHT20_LOG_CS_DDR  DDRB     /**< Data direction register of the flash CS pin */
+    #define __AHT20_LOG_CS_PORT PORTB    /**< Output register of the flash CS pin */
+    #define __AHT20_LOG_CS_PIN  2        /**< Flash CS pin number (PB2 = SS on ATmega328) */
+#endif
+
+
+/* ============================================================================
+ *                         FLASH GEOMETRY
+ * ============================================================================ */
+#ifndef __AHT20_LOG_BASE
+    #define __AHT20_LOG_BASE    0x000000UL  /**< First byte of the log area (sector aligned) */
+#endif
+#ifndef __AHT20_LOG_SIZE
+    #define __AHT20_LOG_SIZE    0x100000UL  /**< Log area size in bytes (1MB = W25Q80, multiple of sector size) */
+#endif
+#ifndef __AHT20_LOG_FLUSH
+    #define __AHT20_LOG_FLUSH   0           /**< Group commit: program after this many pending records (0 = full pages only) */
+#endif
+#define __AHT20_LOG_PAGE_SIZE   256         /**< Program granularity (bytes) */
+#define __AHT20_LOG_SECTOR_SIZE 4096UL      /**< Erase granularity (bytes) */
+#define __AHT20_LOG_ZONE_SIZE   4           /**< Zone map bytes at the end of each page */
+#define __AHT20_LOG_ZONE_ADDR   (__AHT20_LOG_PAGE_SIZE - __AHT20_LOG_ZONE_SIZE)  /**< Zone map offset inside a page */
+#define __AHT20_LOG_LAP_SIZE    2           /**< Lap marker bytes in front of the zone map */
+#define __AHT20_LOG_LAP_ADDR    (__AHT20_LOG_ZONE_ADDR - __AHT20_LOG_LAP_SIZE)  /**< Lap marker offset inside a page */
+#define __AHT20_LOG_PAGE_RECS   (__AHT20_LOG_LAP_ADDR / __AHT20_PACKED_SIZE)  /**< Records per page (50) */
+#define __AHT20_LOG_SECTOR_RECS (__AHT20_LOG_PAGE_RECS * (__AHT20_LOG_SECTOR_SIZE / __AHT20_LOG_PAGE_SIZE))  /**< Records per sector (800) */
+#define __AHT20_LOG_RECORDS     (__AHT20_LOG_PAGE_RECS * (__AHT20_LOG_SIZE / __AHT20_LOG_PAGE_SIZE))  /**< Record indices in the log area */
+
+
+/* ============================================================================
+ *                         FLASH COMMANDS (JEDEC)
+ * ============================================================================ */
+#define __AHT20_LOG_CMD_WREN    0x06     /**< Write enable */
+#define __AHT20_LOG_CMD_RDSR    0x05     /**< Read status register 1 */
+#define __AHT20_LOG_CMD_READ    0x03     /**< Read data */
+#define __AHT20_LOG_CMD_PP      0x02     /**< Page program (up to 256 bytes) */
+#define __AHT20_LOG_CMD_SE      0x20     /**< Sector erase (4KB) */
+#define __AHT20_LOG_FLAG_WIP    0        /**< Write-in-progress bit in status register */
+
+
+/* ============================================================================
+ *                         FUNCTION PROTOTYPES
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Initialize the log and recover the write position
+ * @note Scans the last record of every page, resumes in the first page
+ *       that is not full and reloads its flushed records. Records still
+ *       in the RAM page buffer at power loss are lost: at most 49, or
+ *       __AHT20_LOG_FLUSH - 1 when group commit is enabled.
+ * @note spi.h must be initialized (SPI master mode) before calling.
+ * ------------------------------------------------------- */
+void aht20_logInit(void);
+
+/* -------------------------------------------------------
+ * @brief Start erasing the next sector in the background
+ * @note Call right after aht20_Trigger(). If the next sector is not
+ *       erased yet and the flash is idle, a sector erase is issued and
+ *       the function returns immediately; the chip erases while the
+ *       sensor converts. Otherwise it does nothing.
+ * ------------------------------------------------------- */
+void aht20_logService(void);
+
+/* -------------------------------------------------------
+ * @brief Append one packed sample to the log
+ * @param _Packed: Pointer to __AHT20_PACKED_SIZE bytes from aht20_readPacked()
+ * @note The sample is copied to the RAM page buffer. Every 50th sample
+ *       the full page is sent with a single page program command; the
+ *       function does not wait for programming to finish.
+ * ------------------------------------------------------- */
+void aht20_logAppend(const uint8_t* _Packed);
+
+/* -------------------------------------------------------
+ * @brief Program all buffered samples now
+ * @note Only the records not yet in flash are sent, with one page
+ *       program command. Partial page programming of erased bytes is
+ *       supported by W25Qxx/AT25SF/MX25L parts; check the number of
+ *       partial programs allowed per page (NOP) for other chips.
+ * ------------------------------------------------------- */
+void aht20_logFlush(void);
+
+/* -------------------------------------------------------
+ * @brief Read back one stored sample
+ * @param _Record: Record index inside the log area (0 = first record of first page)
+ * @param _Packed: Pointer to __AHT20_PACKED_SIZE byte buffer
+ * @retval AHT20_Res_T: Status code
+ *         - AHT20_Res_OK: _Packed holds a stored sample
+ *         - AHT20_Res_ERR: Record is empty (erased) or out of range
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_logRead(uint32_t _Record, uint8_t* _Packed);
+
+/* -------------------------------------------------------
+ * @brief Index the next appended sample will get
+ * @retval Record index (0 .. __AHT20_LOG_RECORDS - 1)
+ * ------------------------------------------------------- */
+uint32_t aht20_logNext(void);
+
+/* -------------------------------------------------------
+ * @brief Index of the oldest sample still kept
+ * @retval Record index (0 .. __AHT20_LOG_RECORDS - 1)
+ * @note Retention is one ring: when the log is full the oldest sector
+ *       (800 samples) is reclaimed by the background erase. Only sectors
+ *       whose lap marker belongs to the previous pass count as kept, so
+ *       leftovers on a chip that never wrapped are ignored. Read from
+ *       aht20_logOldest() up to aht20_logNext() (wrapping at
+ *       __AHT20_LOG_RECORDS) to get all kept samples in order.
+ * ------------------------------------------------------- */
+uint32_t aht20_logOldest(void);
+
+/* -------------------------------------------------------
+ * @brief Find the next stored sample above a limit
+ * @param _Temp: true = compare temperature, false = compare humidity
+ * @param _Limit: Limit in 0.01 units (7500 = 75.00%RH, -1000 = -10.00°C)
+ * @param _Record: In: first record to check, Out: matching record
+ * @param _End: Stop before this record (e.g. aht20_logNext()), ring aware
+ * @retval AHT20_Res_T: Status code
+ *         - AHT20_Res_OK: *_Record is a sample above the limit
+ *         - AHT20_Res_ERR: No sample above the limit in the range
+ * @note Full pages whose zone map maximum is below the limit are skipped
+ *       after reading 4 bytes; only candidate pages are read record by
+ *       record. Values are compared as raw integers, without conversion.
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_logFindAbove(bool _Temp, int16_t _Limit, uint32_t* _Record, uint32_t _End);
+
+/* -------------------------------------------------------
+ * @brief Read a range of samples column by column
+ * @param _Record: In: first record to read, Out: where to continue
+ * @param _End: Stop before this record (e.g. aht20_logNext()), ring aware
+ * @param _Humi: Humidity column, Raw16 (NULL = not wanted)
+ * @param _Temp: Temperature column, Raw16 (NULL = not wanted)
+ * @param _Max: Capacity of the column arrays
+ * @retval Number of samples stored in the columns
+ * @note Each page is read with a single READ command instead of one
+ *       command per record. Erased records are skipped. Call again with
+ *       the updated *_Record until it returns 0.
+ * ------------------------------------------------------- */
+uint8_t aht20_logExport(uint32_t* _Record, uint32_t _End, uint16_t* _Humi, uint16_t* _Temp, uint8_t _Max);
+
+/* -------------------------------------------------------
+ * @brief Get the next record slot inside the RAM page buffer
+ * @retval Pointer to __AHT20_PACKED_SIZE bytes (always available)
+ * @note Lets aht20_readPacked() validate straight into the page buffer:
+ *       if (aht20_readPacked(aht20_logReserve()) == AHT20_Res_OK) aht20_logCommit();
+ *       Without aht20_logCommit() the slot is reused by the next sample.
+ * ------------------------------------------------------- */
+uint8_t* aht20_logReserve(void);
+
+/* -------------------------------------------------------
+ * @brief Accept the reserved record, program when the page is full or
+ *        __AHT20_LOG_FLUSH records are pending
+ * ------------------------------------------------------- */
+void aht20_logCommit(void);
+
+#endif /* _aht20_log_H_ */
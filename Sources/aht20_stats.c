@@ -0,0 +1,380 @@
+/**
+ ******************************************************************************
+ * @file     aht20_stats.c
+ * @brief    Mergeable summaries of packed AHT20 samples - implementation
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     EXECUTION FLOW:
+ *           1. Add:
+ *              └─> Extract Raw16 humidity [Byte0:Byte1] and temperature
+ *                  [Byte2[3:0]:Byte3:Byte4[7:4]] → Update count, min, max, sum
+ *                  → Histogram bin = Raw16 × bins / 2^16 → Bin count++
+ *
+ *           2. Add frames:
+ *              └─> Check BUSY/CAL/CRC of each frame → Bad: Busy++ or Errors++
+ *                  → Good: Add the 5 data bytes as above
+ *
+ *           3. Merge:
+ *              └─> Counts, sums, bins and error counters added → Min of mins, max of maxes
+ *
+ *           4. Percentile:
+ *              └─> Rank = pct × count / 100 → Walk bins until rank reached
+ *                  → Interpolate inside the bin → Clamp to [min, max] → 0.01%RH
+ *
+ *           5. Rollup:
+ *              └─> Dist = Id - Newest (signed) → > 0: Clear buckets up to Id, Newest = Id
+ *                  → Dist <= -size: Too late, reject → Add to Bucket[Id % size]
+ *
+ *           6. Outlier check:
+ *              └─> Diff = value - mean → Warmed up and Diff² > Z² × max(Var, floor)? → Flag
+ *                  → Mean += Diff / 2^n → Var += (Diff² - Var) / 2^n
+ *
+ * @note     For detailed documentation with examples, visit:
+ *           https://github.com/aKaReZa75/AVR_AHT20
+ ******************************************************************************
+ */
+
+#include "aht20_stats.h"
+
+
+/* ============================================================================
+ *                       HELPERS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Raw16 humidity to 0.01%RH: Raw16 × 10000 / 2^16
+ * ------------------------------------------------------- */
+static uint16_t aht20_statsHumiUnits(uint32_t _Raw16)
+{
+    return (uint16_t)((_Raw16 * 625UL) >> 12);
+};
+
+/* -------------------------------------------------------
+ * @brief 16-bit counter add that stops at 65535 like Count
+ * ------------------------------------------------------- */
+static uint16_t aht20_statsSat16(uint16_t _Value, uint16_t _Add)
+{
+    uint32_t _Sum = (uint32_t)_Value + _Add;
+
+    return (_Sum > 0xFFFF) ? 0xFFFF : (uint16_t)_Sum;
+};
+
+
+/* ============================================================================
+ *                       PUBLIC FUNCTIONS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Reset a summary to empty
+ * ------------------------------------------------------- */
+void aht20_statsClear(AHT20_Stats_T* _Stats)
+{
+    _Stats->Count = 0;
+    _Stats->HumiMin = 0xFFFF;
+    _Stats->HumiMax = 0;
+    _Stats->TempMin = 0xFFFF;
+    _Stats->TempMax = 0;
+    _Stats->HumiSum = 0;
+    _Stats->TempSum = 0;
+    _Stats->Busy = 0;
+    _Stats->Errors = 0;
+    for(uint8_t _Bin = 0; _Bin < __AHT20_STATS_BINS; _Bin++)
+    {
+        _Stats->HumiHist[_Bin] = 0;
+    };
+};
+
+/* -------------------------------------------------------
+ * @brief Add one packed sample
+ * ------------------------------------------------------- */
+bool aht20_statsAdd(AHT20_Stats_T* _Stats, const uint8_t* _Packed)
+{
+    uint16_t _Humi = __AHT20_HUMI16(_Packed);
+    uint16_t _Temp = __AHT20_TEMP16(_Packed);
+
+    if(_Stats->Count == 0xFFFF)                            /**< Sums would overflow */
+    {
+        return false;
+    };
+
+    _Stats->Count++;
+    _Stats->HumiSum += _Humi;
+    _Stats->TempSum += _Temp;
+
+    if(_Humi < _Stats->HumiMin)
+    {
+        _Stats->HumiMin = _Humi;
+    };
+    if(_Humi > _Stats->HumiMax)
+    {
+        _Stats->HumiMax = _Humi;
+    };
+    if(_Temp < _Stats->TempMin)
+    {
+        _Stats->TempMin = _Temp;
+    };
+    if(_Temp > _Stats->TempMax)
+    {
+        _Stats->TempMax = _Temp;
+    };
+
+    _Stats->HumiHist[((uint32_t)_Humi * __AHT20_STATS_BINS) >> 16]++;
+
+    return true;
+};
+
+/* -------------------------------------------------------
+ * @brief Add a block of captured 7-byte frames
+ * ------------------------------------------------------- */
+uint8_t aht20_statsAddFrames(AHT20_Stats_T* _Stats, const uint8_t* _Frames, uint8_t _Count)
+{
+    uint8_t _Added = 0;
+
+    for(uint8_t _Idx = 0; _Idx < _Count; _Idx++, _Frames += __AHT20_FRAME_SIZE)
+    {
+        AHT20_Res_T _Res = aht20_checkFrame(_Frames);
+
+        if(_Res == AHT20_Res_Busy)
+        {
+            _Stats->Busy = aht20_statsSat16(_Stats->Busy, 1);
+        }
+        else if(_Res != AHT20_Res_OK)
+        {
+            _Stats->Errors = aht20_statsSat16(_Stats->Errors, 1);
+        }
+        else if(aht20_statsAdd(_Stats, _Frames + 1))      /**< Data bytes follow the status byte */
+        {
+            _Added++;
+        };
+    };
+
+    return _Added;
+};
+
+/* -------------------------------------------------------
+ * @brief Merge summary _Src into _Dst
+ * ------------------------------------------------------- */
+bool aht20_statsMerge(AHT20_Stats_T* _Dst, const AHT20_Stats_T* _Src)
+{
+    if((uint32_t)_Dst->Count + _Src->Count > 0xFFFF)
+    {
+        return false;
+    };
+
+    _Dst->Count += _Src->Count;
+    _Dst->HumiSum += _Src->HumiSum;
+    _Dst->TempSum += _Src->TempSum;
+    _Dst->Busy = aht20_statsSat16(_Dst->Busy, _Src->Busy);
+    _Dst->Errors = aht20_statsSat16(_Dst->Errors, _Src->Errors);
+
+    if(_Src->HumiMin < _Dst->HumiMin)
+    {
+        _Dst->HumiMin = _Src->HumiMin;
+    };
+    if(_Src->HumiMax > _Dst->HumiMax)
+    {
+        _Dst->HumiMax = _Src->HumiMax;
+    };
+    if(_Src->TempMin < _Dst->TempMin)
+    {
+        _Dst->TempMin = _Src->TempMin;
+    };
+    if(_Src->TempMax > _Dst->TempMax)
+    {
+        _Dst->TempMax = _Src->TempMax;
+    };
+
+    for(uint8_t _Bin = 0; _Bin < __AHT20_STATS_BINS; _Bin++)
+    {
+        _Dst->HumiHist[_Bin] += _Src->HumiHist[_Bin];
+    };
+
+    return true;
+};
+
+/* -------------------------------------------------------
+ * @brief Estimate a humidity percentile
+ * ------------------------------------------------------- */
+uint16_t aht20_statsHumiPct(const AHT20_Stats_T* _Stats, uint8_t _Pct)
+{
+    uint32_t _Rank;                                        /**< Wanted position, 1..Count */
+    uint32_t _Below = 0;                                   /**< Samples in bins already passed */
+    uint32_t _Value = _Stats->HumiMax;                     /**< Result in Raw16 */
+
+    if(_Stats->Count == 0)
+    {
+        return 0;
+    };
+
+    _Rank = ((uint32_t)_Stats->Count * _Pct + 99) / 100;  /**< Nearest-rank, rounded up */
+    if(_Rank == 0)
+    {
+        _Rank = 1;
+    };
+
+    for(uint8_t _Bin = 0; _Bin < __AHT20_STATS_BINS; _Bin++)
+    {
+        uint16_t _InBin = _Stats->HumiHist[_Bin];
+
+        if(_Below + _InBin >= _Rank)                       /**< Percentile lies in this bin */
+        {
+            uint32_t _Lower = ((uint32_t)_Bin << 16) / __AHT20_STATS_BINS;  /**< Bin edges in Raw16 */
+            uint32_t _Upper = ((uint32_t)(_Bin + 1) << 16) / __AHT20_STATS_BINS;
+
+            _Value = _Lower + ((_Upper - _Lower) * (_Rank - _Below)) / _InBin;
+            break;
+        };
+        _Below += _InBin;
+    };
+
+    if(_Value < _Stats->HumiMin)                           /**< Histogram is coarse: keep inside seen range */
+    {
+        _Value = _Stats->HumiMin;
+    };
+    if(_Value > _Stats->HumiMax)
+    {
+        _Value = _Stats->HumiMax;
+    };
+
+    return aht20_statsHumiUnits(_Value);
+};
+
+/* -------------------------------------------------------
+ * @brief Mean humidity in 0.01%RH
+ * ------------------------------------------------------- */
+uint16_t aht20_statsHumiMean(const AHT20_Stats_T* _Stats)
+{
+    if(_Stats->Count == 0)
+    {
+        return 0;
+    };
+
+    return aht20_statsHumiUnits(_Stats->HumiSum / _Stats->Count);
+};
+
+/* -------------------------------------------------------
+ * @brief Mean temperature in 0.01°C: Raw16 × 20000 / 2^16 - 5000
+ * ------------------------------------------------------- */
+int16_t aht20_statsTempMean(const AHT20_Stats_T* _Stats)
+{
+    if(_Stats->Count == 0)
+    {
+        return 0;
+    };
+
+    return (int16_t)(((_Stats->TempSum / _Stats->Count) * 625UL) >> 11) - 5000;
+};
+
+/* -------------------------------------------------------
+ * @brief Empty all buckets
+ * ------------------------------------------------------- */
+void aht20_rollupInit(AHT20_Rollup_T* _Roll)
+{
+    for(uint8_t _Slot = 0; _Slot < __AHT20_ROLLUP_SIZE; _Slot++)
+    {
+        aht20_statsClear(&_Roll->Bucket[_Slot]);
+    };
+    _Roll->Newest = 0;
+    _Roll->Started = false;
+};
+
+/* -------------------------------------------------------
+ * @brief Add one packed sample to its bucket
+ * ------------------------------------------------------- */
+bool aht20_rollupAdd(AHT20_Rollup_T* _Roll, uint16_t _Id, const uint8_t* _Packed)
+{
+    int16_t _Dist;                                         /**< Buckets ahead of the newest one */
+
+    if(!_Roll->Started)                                    /**< First sample defines the newest bucket */
+    {
+        _Roll->Started = true;
+        _Roll->Newest = _Id;
+    };
+
+    _Dist = (int16_t)(_Id - _Roll->Newest);
+    if(_Dist <= -__AHT20_ROLLUP_SIZE)                      /**< Bucket already reused */
+    {
+        return false;
+    };
+
+    if(_Dist > 0)                                          /**< Open new buckets, dropping the oldest */
+    {
+        if(_Dist > __AHT20_ROLLUP_SIZE)
+        {
+            _Dist = __AHT20_ROLLUP_SIZE;
+        };
+        while(_Dist--)
+        {
+            aht20_statsClear(&_Roll->Bucket[(uint16_t)(_Id - _Dist) % __AHT20_ROLLUP_SIZE]);
+        };
+        _Roll->Newest = _Id;
+    };
+
+    return aht20_statsAdd(&_Roll->Bucket[_Id % __AHT20_ROLLUP_SIZE], _Packed);
+};
+
+/* -------------------------------------------------------
+ * @brief Summary of one bucket
+ * ------------------------------------------------------- */
+const AHT20_Stats_T* aht20_rollupGet(const AHT20_Rollup_T* _Roll, uint16_t _Id)
+{
+    int16_t _Dist = (int16_t)(_Id - _Roll->Newest);
+
+    if(!_Roll->Started || (_Dist > 0) || (_Dist <= -__AHT20_ROLLUP_SIZE))
+    {
+        return NULL;
+    };
+
+    return &_Roll->Bucket[_Id % __AHT20_ROLLUP_SIZE];
+};
+
+/* -------------------------------------------------------
+ * @brief Reset a running mean/variance
+ * ------------------------------------------------------- */
+void aht20_anomInit(AHT20_Anom_T* _Anom)
+{
+    _Anom->Mean = 0;
+    _Anom->Var = 0;
+    _Anom->Count = 0;
+};
+
+/* -------------------------------------------------------
+ * @brief Score one value against the running statistics, then add it
+ * @note Diff is at most 25000 (-50..150°C), so Diff² fits in 32 bits;
+ *       the limit is compared as Diff² / Z² to keep it there
+ * ------------------------------------------------------- */
+bool aht20_anomCheck(AHT20_Anom_T* _Anom, int16_t _Value)
+{
+    int32_t  _Diff;                                        /**< Distance to the mean, 0.01 units */
+    uint32_t _Sq;                                          /**< Diff² */
+    uint32_t _Var = _Anom->Var;
+    bool     _Out = false;
+
+    if(_Anom->Count == 0)                                  /**< First value starts the mean */
+    {
+        _Anom->Mean = (int32_t)_Value << 8;
+    };
+
+    _Diff = (int32_t)_Value - (_Anom->Mean >> 8);
+    _Sq = (uint32_t)(_Diff * _Diff);
+
+    if(_Var < __AHT20_ANOM_FLOOR)
+    {
+        _Var = __AHT20_ANOM_FLOOR;
+    };
+    if(_Anom->Count >= (1 << __AHT20_ANOM_SHIFT))          /**< Warmed up: statistics are meaningful */
+    {
+        _Out = (_Sq / (__AHT20_ANOM_Z * __AHT20_ANOM_Z) > _Var);
+    }
+    else
+    {
+        _Anom->Count++;
+    };
+
+    _Anom->Mean += (((int32_t)_Value << 8) - _Anom->Mean) >> __AHT20_ANOM_SHIFT;
+    _Anom->Var = _Anom->Var - (_Anom->Var >> __AHT20_ANOM_SHIFT) + (_Sq >> __AHT20_ANOM_SHIFT);
+
+    return _Out;
+};
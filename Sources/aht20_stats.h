@@ -0,0 +1,210 @@
+/**
+ ******************************************************************************
+ * @file     aht20_stats.h
+ * @brief    Mergeable summaries of packed AHT20 samples
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     A summary keeps count, min, max and sum of temperature and
+ *           humidity plus a fixed-bin humidity histogram. Summaries of
+ *           different sensors or time blocks merge by simple addition, so
+ *           percentiles over any group can be answered from the summaries
+ *           alone, without the raw samples.
+ *
+ * @note     FUNCTION SUMMARY:
+ *           - aht20_statsClear      : Reset a summary
+ *           - aht20_statsAdd        : Add one packed sample
+ *           - aht20_statsAddFrames  : Add a block of captured 7-byte frames, counting bad ones
+ *           - aht20_statsMerge      : Add summary B into summary A
+ *           - aht20_statsHumiPct    : Humidity percentile (0.01%RH) from the histogram
+ *           - aht20_statsHumiMean / aht20_statsTempMean : Mean values (0.01 units)
+ *           - aht20_anomInit / aht20_anomCheck : Running mean/variance outlier flag (z-score)
+ *           - aht20_rollupInit / aht20_rollupAdd / aht20_rollupGet : Summaries per time bucket, updated on ingest
+ *
+ * @note     Values are kept as the upper 16 of the 20 raw bits
+ *           (0.0015%RH / 0.003°C resolution) so sums fit in 32 bits.
+ *
+ * @note     For detailed documentation with examples, visit:
+ *           https://github.com/aKaReZa75/AVR_AHT20
+ ******************************************************************************
+ */
+#ifndef _aht20_stats_H_
+#define _aht20_stats_H_
+
+#include "aht20.h"
+
+
+/* ============================================================================
+ *                         SUMMARY CONFIGURATION
+ * ============================================================================ */
+#ifndef __AHT20_STATS_BINS
+    #define __AHT20_STATS_BINS  20       /**< Humidity histogram bins over 0..100%RH (20 = 5%RH per bin) */
+#endif
+#ifndef __AHT20_ROLLUP_SIZE
+    #define __AHT20_ROLLUP_SIZE 4        /**< Buckets kept open for reads and late samples: power of two, 1..128 (RAM = size × sizeof(AHT20_Stats_T)) */
+#endif
+
+#if (__AHT20_ROLLUP_SIZE < 1) || (__AHT20_ROLLUP_SIZE > 128) || (__AHT20_ROLLUP_SIZE & (__AHT20_ROLLUP_SIZE - 1))
+    #error "__AHT20_ROLLUP_SIZE must be a power of two between 1 and 128 (Id % size must stay continuous across the 16-bit Id wrap)"
+#endif
+#ifndef __AHT20_ANOM_SHIFT
+    #define __AHT20_ANOM_SHIFT  4        /**< Running average weight 1/2^n (4 = last ~16 samples) */
+#endif
+#if __AHT20_ANOM_SHIFT > 7
+    #error "__AHT20_ANOM_SHIFT must be 7 or less (the 8-bit warm-up counter in AHT20_Anom_T counts to 2^n)"
+#endif
+#ifndef __AHT20_ANOM_Z
+    #define __AHT20_ANOM_Z      4        /**< Outlier when |value - mean| > Z × standard deviation */
+#endif
+#ifndef __AHT20_ANOM_FLOOR
+    #define __AHT20_ANOM_FLOOR  25       /**< Minimum variance in (0.01 units)^2 (25 = 0.05 std), avoids flags on a flat signal */
+#endif
+
+
+/* ============================================================================
+ *                         TYPE DEFINITIONS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Mergeable summary (22 + 2 × __AHT20_STATS_BINS bytes, 62 with the default bins)
+ * @note Raw16 scale: humidity 0..65535 = 0..100%RH,
+ *       temperature 0..65535 = -50..150°C
+ * ------------------------------------------------------- */
+typedef struct
+{
+    uint16_t Count;                      /**< Number of samples (saturates at 65535) */
+    uint16_t HumiMin;                    /**< Lowest humidity (Raw16) */
+    uint16_t HumiMax;                    /**< Highest humidity (Raw16) */
+    uint16_t TempMin;                    /**< Lowest temperature (Raw16) */
+    uint16_t TempMax;                    /**< Highest temperature (Raw16) */
+    uint32_t HumiSum;                    /**< Sum of humidity values (Raw16) */
+    uint32_t TempSum;                    /**< Sum of temperature values (Raw16) */
+    uint16_t HumiHist[__AHT20_STATS_BINS];  /**< Humidity histogram */
+    uint16_t Busy;                       /**< Frames with BUSY set (read too early, saturates at 65535) */
+    uint16_t Errors;                     /**< Frames with CAL clear or CRC mismatch (saturates at 65535) */
+} AHT20_Stats_T;
+
+/* -------------------------------------------------------
+ * @brief Ring of summaries, one per bucket (e.g. one minute)
+ * @note Bucket Id is chosen by the caller: timestamp / bucket length or
+ *       sequence number / samples per bucket
+ * ------------------------------------------------------- */
+typedef struct
+{
+    AHT20_Stats_T Bucket[__AHT20_ROLLUP_SIZE];  /**< Slot = Id % __AHT20_ROLLUP_SIZE */
+    uint16_t      Newest;                /**< Id of the newest bucket */
+    bool          Started;               /**< false until the first sample */
+} AHT20_Rollup_T;
+
+/* -------------------------------------------------------
+ * @brief Running mean/variance of one value (exponentially weighted)
+ * ------------------------------------------------------- */
+typedef struct
+{
+    int32_t  Mean;                       /**< Mean in 0.01 units × 256 */
+    uint32_t Var;                        /**< Variance in (0.01 units)^2 */
+    uint8_t  Count;                      /**< Samples seen, stops at warm-up length */
+} AHT20_Anom_T;
+
+
+/* ============================================================================
+ *                         FUNCTION PROTOTYPES
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Reset a summary to empty
+ * ------------------------------------------------------- */
+void aht20_statsClear(AHT20_Stats_T* _Stats);
+
+/* -------------------------------------------------------
+ * @brief Add one packed sample
+ * @param _Stats: Summary
+ * @param _Packed: __AHT20_PACKED_SIZE bytes from aht20_readPacked() or the log
+ * @retval true: Added, false: Summary full (Count = 65535)
+ * ------------------------------------------------------- */
+bool aht20_statsAdd(AHT20_Stats_T* _Stats, const uint8_t* _Packed);
+
+/* -------------------------------------------------------
+ * @brief Add a block of captured 7-byte frames
+ * @param _Stats: Summary
+ * @param _Frames: _Count frames of __AHT20_FRAME_SIZE bytes back to back
+ * @param _Count: Number of frames
+ * @retval Number of valid frames added
+ * @note Invalid frames are counted in Busy / Errors. Summaries of
+ *       separate chunks of one capture merge into the same result as
+ *       one pass over the whole capture.
+ * @note Once Count reached 65535, valid frames are neither added nor
+ *       counted anywhere: the return value is then lower than the number
+ *       of valid frames. Start a new summary (e.g. per chunk) and merge.
+ * ------------------------------------------------------- */
+uint8_t aht20_statsAddFrames(AHT20_Stats_T* _Stats, const uint8_t* _Frames, uint8_t _Count);
+
+/* -------------------------------------------------------
+ * @brief Merge summary _Src into _Dst
+ * @retval true: Merged, false: Combined count would exceed 65535 (_Dst unchanged)
+ * ------------------------------------------------------- */
+bool aht20_statsMerge(AHT20_Stats_T* _Dst, const AHT20_Stats_T* _Src);
+
+/* -------------------------------------------------------
+ * @brief Estimate a humidity percentile
+ * @param _Stats: Summary
+ * @param _Pct: Percentile 0..100
+ * @retval Humidity in 0.01%RH (linear interpolation inside the bin,
+ *         clamped to min/max); 0 for an empty summary
+ * ------------------------------------------------------- */
+uint16_t aht20_statsHumiPct(const AHT20_Stats_T* _Stats, uint8_t _Pct);
+
+/* -------------------------------------------------------
+ * @brief Mean humidity in 0.01%RH (0 for an empty summary)
+ * ------------------------------------------------------- */
+uint16_t aht20_statsHumiMean(const AHT20_Stats_T* _Stats);
+
+/* -------------------------------------------------------
+ * @brief Mean temperature in 0.01°C (0 for an empty summary)
+ * ------------------------------------------------------- */
+int16_t aht20_statsTempMean(const AHT20_Stats_T* _Stats);
+
+/* -------------------------------------------------------
+ * @brief Empty all buckets
+ * ------------------------------------------------------- */
+void aht20_rollupInit(AHT20_Rollup_T* _Roll);
+
+/* -------------------------------------------------------
+ * @brief Add one packed sample to its bucket
+ * @param _Roll: Bucket ring
+ * @param _Id: Bucket of the sample
+ * @param _Packed: __AHT20_PACKED_SIZE bytes
+ * @retval true: Added
+ *         false: Bucket already dropped (older than __AHT20_ROLLUP_SIZE
+ *         buckets before the newest) or full
+ * @note A newer Id opens its bucket and clears the ones it overwrites.
+ *       A late sample for a bucket still in the ring updates only that
+ *       bucket. Comparison is wrap-safe like aht20_seqCheck().
+ * ------------------------------------------------------- */
+bool aht20_rollupAdd(AHT20_Rollup_T* _Roll, uint16_t _Id, const uint8_t* _Packed);
+
+/* -------------------------------------------------------
+ * @brief Summary of one bucket
+ * @retval Pointer to the summary, NULL if the bucket is not in the ring
+ * @note Merge consecutive buckets with aht20_statsMerge() for longer
+ *       periods; save the oldest one before a new Id overwrites it
+ * ------------------------------------------------------- */
+const AHT20_Stats_T* aht20_rollupGet(const AHT20_Rollup_T* _Roll, uint16_t _Id);
+
+/* -------------------------------------------------------
+ * @brief Reset a running mean/variance
+ * ------------------------------------------------------- */
+void aht20_anomInit(AHT20_Anom_T* _Anom);
+
+/* -------------------------------------------------------
+ * @brief Score one value against the running statistics, then add it
+ * @param _Anom: Running statistics of this series
+ * @param _Value: Value in 0.01 units (aht20_decodeFrames(), __AHT20_LITE data)
+ * @retval true: Outlier (|value - mean| > __AHT20_ANOM_Z standard deviations)
+ * @note No flags during the first 2^__AHT20_ANOM_SHIFT samples (warm-up).
+ *       Constant time, no division by a variable and no square root.
+ * ------------------------------------------------------- */
+bool aht20_anomCheck(AHT20_Anom_T* _Anom, int16_t _Value);
+
+#endif /* _aht20_stats_H_ */
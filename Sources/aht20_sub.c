@@ -0,0 +1,243 @@
+/**
+ ******************************************************************************
+ * @file     aht20_sub.c
+ * @brief    One AHT20 acquisition stream shared by several consumers - implementation
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     EXECUTION FLOW:
+ *           1. Register:
+ *              └─> Store sink, period, averaging → Base = smallest period
+ *                  → Ratio of every consumer = period / base (rounded, 1..255)
+ *                  → Ratio changed? → Restart its count and sums
+ *
+ *           2. Poll:
+ *              └─> Idle and base period elapsed? → aht20_Trigger() → Converting
+ *                  → 80ms elapsed? → aht20_readPacked() → Busy: retry next poll
+ *                  → OK: Dispatch → Idle
+ *
+ *           3. Dispatch (per consumer):
+ *              └─> Averaging? → Add 20-bit raw values to sums
+ *                  → Count++ → Count == Ratio? → Deliver latest or sum / count
+ *                  → Clear count and sums
+ *
+ * @note     For detailed documentation with examples, visit:
+ *           https://github.com/aKaReZa75/AVR_AHT20
+ ******************************************************************************
+ */
+
+#include "aht20_sub.h"
+#include "aht20_internal.h"
+
+
+/* ============================================================================
+ *                       CONSUMER STATE
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief One registered consumer
+ * ------------------------------------------------------- */
+typedef struct
+{
+    AHT20_Sink_T Sink;                   /**< Callback */
+    uint16_t     Period;                 /**< Wanted period in ms */
+    uint8_t      Ratio;                  /**< Base samples per delivery */
+    uint8_t      Count;                  /**< Base samples since the last delivery */
+    bool         Average;                /**< Deliver the mean instead of the latest sample */
+    uint32_t     HumiSum;                /**< Sum of 20-bit raw humidity (255 × 2^20 fits) */
+    uint32_t     TempSum;                /**< Sum of 20-bit raw temperature */
+} AHT20_Sub_T;
+
+static AHT20_Sub_T _subList[__AHT20_SUB_MAX];              /**< Registered consumers */
+static uint8_t     _subCount = 0;                          /**< Number of registered consumers */
+static uint16_t    _subBase = 0;                           /**< Measurement period in ms */
+static uint16_t    _subTrigger;                            /**< Tick of the last trigger */
+static bool        _subBusy = false;                       /**< Conversion in progress */
+static bool        _subStarted = false;                    /**< First trigger done */
+
+
+/* ============================================================================
+ *                       HELPERS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Recompute the base period and every consumer's ratio
+ * ------------------------------------------------------- */
+static void _sub_Plan(void)
+{
+    _subBase = 0xFFFF;
+    for(uint8_t _Idx = 0; _Idx < _subCount; _Idx++)
+    {
+        if(_subList[_Idx].Period < _subBase)
+        {
+            _subBase = _subList[_Idx].Period;
+        };
+    };
+
+    for(uint8_t _Idx = 0; _Idx < _subCount; _Idx++)
+    {
+        AHT20_Sub_T* _Sub = &_subList[_Idx];
+        uint16_t     _Ratio = (_Sub->Period + _subBase / 2) / _subBase;
+
+        if(_Ratio > 0xFF)
+        {
+            _Ratio = 0xFF;
+        };
+        if(_Ratio != _Sub->Ratio)                          /**< Base changed: partial sums belong to the old ratio */
+        {
+            _Sub->Count = 0;
+            _Sub->HumiSum = 0;
+            _Sub->TempSum = 0;
+        };
+        _Sub->Ratio = (uint8_t)_Ratio;
+    };
+};
+
+
+/* ============================================================================
+ *                       PUBLIC FUNCTIONS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Remove all consumers
+ * ------------------------------------------------------- */
+void aht20_subInit(void)
+{
+    _subCount = 0;
+    _subBase = 0;
+    _subBusy = false;
+    _subStarted = false;
+};
+
+/* -------------------------------------------------------
+ * @brief Register a consumer
+ * ------------------------------------------------------- */
+bool aht20_subAdd(AHT20_Sink_T _Sink, uint16_t _Period, bool _Average)
+{
+    AHT20_Sub_T* _Sub;
+
+    if(_subCount >= __AHT20_SUB_MAX)
+    {
+        return false;
+    };
+
+    _Sub = &_subList[_subCount];
+    _Sub->Sink = _Sink;
+    _Sub->Period = (_Period == 0) ? 1 : _Period;
+    _Sub->Average = _Average;
+    _Sub->Count = 0;
+    _Sub->HumiSum = 0;
+    _Sub->TempSum = 0;
+    _subCount++;
+
+    _sub_Plan();
+    return true;
+};
+
+/* -------------------------------------------------------
+ * @brief Measurement period
+ * ------------------------------------------------------- */
+uint16_t aht20_subPeriod(void)
+{
+    return _subBase;
+};
+
+/* -------------------------------------------------------
+ * @brief Feed one valid sample to all consumers
+ * ------------------------------------------------------- */
+void aht20_subDispatch(const uint8_t* _Packed)
+{
+    uint8_t  _Mean[__AHT20_PACKED_SIZE];                   /**< Averaged sample, packed again */
+    uint32_t _Humi, _Temp;                                 /**< 20-bit raw values */
+
+    aht20_rawExtract(_Packed, &_Humi, &_Temp);
+
+    for(uint8_t _Idx = 0; _Idx < _subCount; _Idx++)
+    {
+        AHT20_Sub_T* _Sub = &_subList[_Idx];
+
+        if(_Sub->Average)
+        {
+            _Sub->HumiSum += _Humi;
+            _Sub->TempSum += _Temp;
+        };
+
+        if(++_Sub->Count < _Sub->Ratio)                    /**< Not this consumer's turn */
+        {
+            continue;
+        };
+
+        if(_Sub->Average)
+        {
+            uint32_t _HumiMean = (_Sub->HumiSum + _Sub->Count / 2) / _Sub->Count;
+            uint32_t _TempMean = (_Sub->TempSum + _Sub->Count / 2) / _Sub->Count;
+
+            _Mean[0] = _HumiMean >> 12;
+            _Mean[1] = _HumiMean >> 4;
+            _Mean[2] = (uint8_t)(_HumiMean << 4) | (uint8_t)(_TempMean >> 16);
+            _Mean[3] = _TempMean >> 8;
+            _Mean[4] = _TempMean;
+            _Sub->HumiSum = 0;
+            _Sub->TempSum = 0;
+            _Sub->Sink(_Mean);
+        }
+        else
+        {
+            _Sub->Sink(_Packed);
+        };
+        _Sub->Count = 0;
+    };
+};
+
+/* -------------------------------------------------------
+ * @brief Run acquisition without blocking
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_subPoll(uint16_t _Now)
+{
+    uint8_t     _Packed[__AHT20_PACKED_SIZE];
+    AHT20_Res_T _Res;
+
+    if(_subCount == 0)
+    {
+        return AHT20_Res_Busy;
+    };
+
+    if(!_subBusy)
+    {
+        if(_subStarted && ((uint16_t)(_Now - _subTrigger) < _subBase))  /**< Fastest consumer not due yet */
+        {
+            return AHT20_Res_Busy;
+        };
+        _subTrigger = _Now;
+        _subStarted = true;
+        if(aht20_Trigger() != AHT20_Res_OK)                /**< Bus failed: try again next period */
+        {
+            return AHT20_Res_ERR;
+        };
+        _subBusy = true;
+        return AHT20_Res_Busy;
+    };
+
+    if((uint16_t)(_Now - _subTrigger) < __AHT20_MEASURE_DELAY)  /**< Still converting */
+    {
+        return AHT20_Res_Busy;
+    };
+
+    _Res = aht20_readPacked(_Packed);
+    if(_Res == AHT20_Res_Busy)
+    {
+        if((uint16_t)(_Now - _subTrigger) < 2 * __AHT20_MEASURE_DELAY)  /**< Retry on the next poll */
+        {
+            return AHT20_Res_Busy;
+        };
+        _Res = AHT20_Res_TimeOut;                          /**< Sensor stuck: give up this measurement */
+    };
+    _subBusy = false;
+
+    if(_Res == AHT20_Res_OK)
+    {
+        aht20_subDispatch(_Packed);
+    };
+    return _Res;
+};
@@ -0,0 +1,110 @@
+/**
+ ******************************************************************************
+ * @file     aht20_sub.h
+ * @brief    One AHT20 acquisition stream shared by several consumers
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     Consumers (display, logger, controller, ...) register a sink
+ *           function and the period they want samples at. The sensor is
+ *           measured only at the period of the fastest consumer; every
+ *           other consumer gets every n-th sample, or the average of the
+ *           last n samples, counted with integer counters when a frame
+ *           completes.
+ *
+ * @note     FUNCTION SUMMARY:
+ *           - aht20_subInit     : Remove all consumers
+ *           - aht20_subAdd      : Register a consumer (sink, period, averaging)
+ *           - aht20_subPeriod   : Measurement period (fastest consumer)
+ *           - aht20_subPoll     : Non-blocking trigger/read state machine, call from the main loop
+ *           - aht20_subDispatch : Feed one valid sample to all consumers (own acquisition loop)
+ *
+ * @note     Usage Example:
+ *           aht20_subInit();
+ *           aht20_subAdd(controlSink, 100, false);    // every sample, 10 Hz
+ *           aht20_subAdd(displaySink, 1000, true);    // mean of 10 samples, 1 Hz
+ *           aht20_subAdd(logSink, 10000, true);       // mean of 100 samples, 0.1 Hz
+ *           while(1) {
+ *               aht20_subPoll((uint16_t)millis());
+ *           }
+ *
+ * @note     For detailed documentation with examples, visit:
+ *           https://github.com/aKaReZa75/AVR_AHT20
+ ******************************************************************************
+ */
+#ifndef _aht20_sub_H_
+#define _aht20_sub_H_
+
+#include "aht20.h"
+
+
+/* ============================================================================
+ *                         CONSUMER CONFIGURATION
+ * ============================================================================ */
+#ifndef __AHT20_SUB_MAX
+    #define __AHT20_SUB_MAX     4        /**< Number of consumers (RAM = 15 bytes each) */
+#endif
+
+
+/* ============================================================================
+ *                         TYPE DEFINITIONS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Consumer callback
+ * @param _Packed: __AHT20_PACKED_SIZE bytes (convert with aht20_Unpack())
+ * @note Called from aht20_subPoll() / aht20_subDispatch(), keep it short
+ * ------------------------------------------------------- */
+typedef void (*AHT20_Sink_T)(const uint8_t* _Packed);
+
+
+/* ============================================================================
+ *                         FUNCTION PROTOTYPES
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Remove all consumers and restart the poll state machine
+ * ------------------------------------------------------- */
+void aht20_subInit(void);
+
+/* -------------------------------------------------------
+ * @brief Register a consumer
+ * @param _Sink: Callback receiving the samples
+ * @param _Period: Wanted sample period in ms (>= __AHT20_MEASURE_DELAY + 20)
+ * @param _Average: true = deliver the mean of the samples since the last
+ *                  delivery, false = deliver the latest sample only
+ * @retval true: Registered, false: __AHT20_SUB_MAX consumers already
+ * @note Ratios of all consumers are recomputed against the fastest one
+ *       (rounded, 1..255). A consumer added later starts a new count.
+ * ------------------------------------------------------- */
+bool aht20_subAdd(AHT20_Sink_T _Sink, uint16_t _Period, bool _Average);
+
+/* -------------------------------------------------------
+ * @brief Measurement period
+ * @retval Period of the fastest consumer in ms, 0 if none registered
+ * ------------------------------------------------------- */
+uint16_t aht20_subPeriod(void);
+
+/* -------------------------------------------------------
+ * @brief Run acquisition without blocking
+ * @param _Now: Millisecond tick (free running, wraps at 65535)
+ * @retval AHT20_Res_T: Status code
+ *         - AHT20_Res_OK: A sample was read and dispatched in this call
+ *         - AHT20_Res_Busy: Nothing to do yet (waiting or converting)
+ *         - AHT20_Res_ERR: Frame invalid (CAL/CRC) or bus transfer failed, dropped
+ *         - AHT20_Res_TimeOut: Still busy after 2 × __AHT20_MEASURE_DELAY, dropped
+ * @note Triggers once per aht20_subPeriod(), reads after
+ *       __AHT20_MEASURE_DELAY and retries while the sensor is busy
+ * ------------------------------------------------------- */
+AHT20_Res_T aht20_subPoll(uint16_t _Now);
+
+/* -------------------------------------------------------
+ * @brief Feed one valid sample to all consumers
+ * @param _Packed: __AHT20_PACKED_SIZE bytes from aht20_readPacked()
+ * @note For applications with their own acquisition loop; measure at
+ *       aht20_subPeriod() and do not call aht20_subPoll()
+ * ------------------------------------------------------- */
+void aht20_subDispatch(const uint8_t* _Packed);
+
+#endif /* _aht20_sub_H_ */
@@ -0,0 +1,276 @@
+/**
+ ******************************************************************************
+ * @file     aht20_usi.c
+ * @brief    USI based I2C master backend implementation (ATtiny25/45/85)
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     EXECUTION FLOW:
+ *           1. Byte Transmit:
+ *              └─> SCL LOW → Load USIDR → Clock 16 edges (8 bits out)
+ *                  → Release SDA → Clock 2 edges → Sample ACK bit (0 = ACK)
+ *
+ *           2. Byte Receive:
+ *              └─> Release SDA → Clock 16 edges (8 bits in) → Read USIDR
+ *                  → Load ACK (0x00) or NACK (0xFF, last byte) → Clock 2 edges
+ *
+ *           3. Clock Edge (one USITC toggle):
+ *              └─> Wait T2 → Toggle SCL HIGH → Wait until SCL really HIGH
+ *                  (slave clock stretching, at most __AHT20_USI_STRETCH us,
+ *                  longest wait recorded) → Wait T4 → Toggle SCL LOW
+ *              └─> Stretch timeout → Transfer marked failed, remaining edges
+ *                  clocked without waiting, finished with STOP
+ *
+ * @note     Based on Atmel application note AVR310 (USI as TWI master).
+ *
+ * @note     For detailed documentation with examples, visit:
+ *           https://github.com/aKaReZa75/AVR_AHT20
+ ******************************************************************************
+ */
+
+#include "aht20_usi.h"
+
+
+static bool     _usiTimeout = false;                       /**< A clock stretch timed out in this transfer */
+static uint16_t _usiStretchMax = 0;                        /**< Longest stretch seen (us) */
+
+
+/* ============================================================================
+ *                       LOW LEVEL HELPERS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Wait until SCL is really HIGH (slave may stretch the clock)
+ * @note On timeout the transfer is marked failed; the master goes on
+ *       clocking without waiting so the bus still ends with a STOP and a
+ *       stuck SCL costs one timeout per transfer, not one per edge
+ * ------------------------------------------------------- */
+static void aht20_usiWaitSCL(void)
+{
+    uint16_t _Wait = 0;
+
+    if(_usiTimeout)                                        /**< Bus already stuck: do not wait again on every edge */
+    {
+        return;
+    };
+
+    while(bitCheckLow(__AHT20_USI_PIN, __AHT20_USI_SCL))
+    {
+        if(_Wait >= __AHT20_USI_STRETCH)
+        {
+            _usiTimeout = true;
+            break;
+        };
+        delay_us(1);
+        _Wait++;
+    };
+
+    if(_Wait > _usiStretchMax)
+    {
+        _usiStretchMax = _Wait;
+    };
+};
+
+/* -------------------------------------------------------
+ * @brief Clock bits through USIDR until the 4-bit counter overflows
+ * @param _Status: __AHT20_USI_SR_8BIT or __AHT20_USI_SR_1BIT
+ * @retval Content of USIDR (received bits)
+ * ------------------------------------------------------- */
+static uint8_t aht20_usiTransfer(uint8_t _Status)
+{
+    uint8_t _Data;
+
+    USISR = _Status;                                       /**< Clear flags and preset edge counter */
+    do
+    {
+        delay_us(__AHT20_USI_T2);
+        USICR |= (1 << USITC);                             /**< SCL HIGH (positive edge) */
+        aht20_usiWaitSCL();                                /**< Wait while slave stretches the clock */
+        delay_us(__AHT20_USI_T4);
+        USICR |= (1 << USITC);                             /**< SCL LOW (negative edge) */
+    } while(bitCheckLow(USISR, USIOIF));                   /**< Until counter overflow */
+
+    delay_us(__AHT20_USI_T2);
+    _Data = USIDR;
+    USIDR = 0xFF;                                          /**< Release SDA */
+    bitSet(__AHT20_USI_DDR, __AHT20_USI_SDA);              /**< SDA back to output (driven by USIDR MSB) */
+
+    return _Data;
+};
+
+/* -------------------------------------------------------
+ * @brief Generate START (or repeated START) condition
+ * ------------------------------------------------------- */
+static void aht20_usiStart(void)
+{
+    bitSet(__AHT20_USI_PORT, __AHT20_USI_SCL);             /**< Release SCL */
+    aht20_usiWaitSCL();
+    delay_us(__AHT20_USI_T2);
+
+    bitClear(__AHT20_USI_PORT, __AHT20_USI_SDA);           /**< SDA falls while SCL HIGH */
+    delay_us(__AHT20_USI_T4);
+    bitClear(__AHT20_USI_PORT, __AHT20_USI_SCL);
+    bitSet(__AHT20_USI_PORT, __AHT20_USI_SDA);             /**< Hand SDA over to USIDR */
+};
+
+/* -------------------------------------------------------
+ * @brief Generate STOP condition
+ * ------------------------------------------------------- */
+static void aht20_usiStop(void)
+{
+    bitClear(__AHT20_USI_PORT, __AHT20_USI_SDA);           /**< SDA LOW */
+    bitSet(__AHT20_USI_PORT, __AHT20_USI_SCL);             /**< Release SCL */
+    aht20_usiWaitSCL();
+    delay_us(__AHT20_USI_T4);
+    bitSet(__AHT20_USI_PORT, __AHT20_USI_SDA);             /**< SDA rises while SCL HIGH */
+    delay_us(__AHT20_USI_T2);
+};
+
+/* -------------------------------------------------------
+ * @brief Send one byte and sample the ACK bit
+ * @retval true: ACK, false: NACK
+ * ------------------------------------------------------- */
+static bool aht20_usiSendByte(uint8_t _Byte)
+{
+    bitClear(__AHT20_USI_PORT, __AHT20_USI_SCL);
+    USIDR = _Byte;
+    aht20_usiTransfer(__AHT20_USI_SR_8BIT);
+
+    bitClear(__AHT20_USI_DDR, __AHT20_USI_SDA);            /**< SDA input: slave drives ACK */
+    return bitCheckLow(aht20_usiTransfer(__AHT20_USI_SR_1BIT), 0);
+};
+
+/* -------------------------------------------------------
+ * @brief Receive one byte and send ACK (or NACK for the last byte)
+ * ------------------------------------------------------- */
+static uint8_t aht20_usiReceiveByte(bool _Last)
+{
+    uint8_t _Byte;
+
+    bitClear(__AHT20_USI_DDR, __AHT20_USI_SDA);            /**< SDA input: slave drives data */
+    _Byte = aht20_usiTransfer(__AHT20_USI_SR_8BIT);
+
+    USIDR = _Last ? 0xFF : 0x00;                           /**< NACK ends the read, ACK requests more */
+    aht20_usiTransfer(__AHT20_USI_SR_1BIT);
+
+    return _Byte;
+};
+
+/* -------------------------------------------------------
+ * @brief Send bytes of an already started write transfer
+ * ------------------------------------------------------- */
+static bool aht20_usiSendAll(uint8_t _Add, const uint8_t* _Data, uint8_t _Len)
+{
+    if(!aht20_usiSendByte((uint8_t)(_Add << 1)))           /**< Address + W */
+    {
+        return false;
+    };
+
+    while(_Len--)
+    {
+        if(!aht20_usiSendByte(*_Data++))
+        {
+            return false;
+        };
+    };
+
+    return true;
+};
+
+/* -------------------------------------------------------
+ * @brief Receive bytes after START (address + R included)
+ * ------------------------------------------------------- */
+static bool aht20_usiReceiveAll(uint8_t _Add, uint8_t* _Data, uint8_t _Len)
+{
+    if(!aht20_usiSendByte((uint8_t)(_Add << 1) | 0x01))    /**< Address + R */
+    {
+        return false;
+    };
+
+    while(_Len--)
+    {
+        *_Data++ = aht20_usiReceiveByte(_Len == 0);
+    };
+
+    return true;
+};
+
+
+/* ============================================================================
+ *                       PUBLIC FUNCTIONS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Configure SDA/SCL and USI for two-wire master mode
+ * ------------------------------------------------------- */
+void aht20_usiInit(void)
+{
+    bitSet(__AHT20_USI_PORT, __AHT20_USI_SDA);             /**< Idle HIGH (released) */
+    bitSet(__AHT20_USI_PORT, __AHT20_USI_SCL);
+    bitSet(__AHT20_USI_DDR, __AHT20_USI_SDA);
+    bitSet(__AHT20_USI_DDR, __AHT20_USI_SCL);
+
+    USIDR = 0xFF;                                          /**< Release SDA */
+    USICR = (1 << USIWM1) | (1 << USICS1) | (1 << USICLK); /**< Two-wire mode, software clock strobe (USITC) */
+    USISR = (1 << USISIF) | (1 << USIOIF) | (1 << USIPF) | (1 << USIDC);  /**< Clear flags and counter */
+    _usiStretchMax = 0;
+};
+
+/* -------------------------------------------------------
+ * @brief Longest clock stretch seen since aht20_usiInit()
+ * ------------------------------------------------------- */
+uint16_t aht20_usiStretchMax(void)
+{
+    return _usiStretchMax;
+};
+
+/* -------------------------------------------------------
+ * @brief Write bytes to a slave
+ * ------------------------------------------------------- */
+bool aht20_usiWrite(uint8_t _Add, const uint8_t* _Data, uint8_t _Len)
+{
+    bool _Ack;
+
+    _usiTimeout = false;
+    aht20_usiStart();
+    _Ack = aht20_usiSendAll(_Add, _Data, _Len);
+    aht20_usiStop();
+
+    return _Ack && !_usiTimeout;
+};
+
+/* -------------------------------------------------------
+ * @brief Read bytes from a slave
+ * ------------------------------------------------------- */
+bool aht20_usiRead(uint8_t _Add, uint8_t* _Data, uint8_t _Len)
+{
+    bool _Ack;
+
+    _usiTimeout = false;
+    aht20_usiStart();
+    _Ack = aht20_usiReceiveAll(_Add, _Data, _Len);
+    aht20_usiStop();
+
+    return _Ack && !_usiTimeout;
+};
+
+/* -------------------------------------------------------
+ * @brief Write a command, then read the answer after a repeated START
+ * ------------------------------------------------------- */
+bool aht20_usiReadSequential(uint8_t _Add, const uint8_t* _Cmd, uint8_t _CmdLen, uint8_t* _Data, uint8_t _Len)
+{
+    bool _Ack;
+
+    _usiTimeout = false;
+    aht20_usiStart();
+    _Ack = aht20_usiSendAll(_Add, _Cmd, _CmdLen);
+    if(_Ack)
+    {
+        aht20_usiStart();                                  /**< Repeated START */
+        _Ack = aht20_usiReceiveAll(_Add, _Data, _Len);
+    };
+    aht20_usiStop();
+
+    return _Ack && !_usiTimeout;
+};
@@ -0,0 +1,119 @@
+/**
+ ******************************************************************************
+ * @file     aht20_usi.h
+ * @brief    USI based I2C master backend for the AHT20 driver (ATtiny25/45/85)
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     ATtiny devices have no TWI peripheral. This backend drives the
+ *           Universal Serial Interface (USI) in two-wire mode with a software
+ *           clock strobe (AVR310 method) and provides the three bus
+ *           primitives the AHT20 driver needs.
+ *
+ * @note     FUNCTION SUMMARY:
+ *           - aht20_usiInit           : Configure pins and USI for two-wire master mode
+ *           - aht20_usiWrite          : START → address+W → data bytes → STOP
+ *           - aht20_usiRead           : START → address+R → data bytes → STOP
+ *           - aht20_usiReadSequential : Write command, repeated START, read data
+ *           - aht20_usiStretchMax     : Longest clock stretch seen by the slave (us)
+ *
+ * @note     Selection:
+ *           #define __AHT20_BUS __AHT20_BUS_USI   (before including aht20.h)
+ *           The driver then calls these functions instead of i2c.h.
+ *
+ * @note     Pins (ATtiny85): SDA = PB0, SCL = PB2, external pull-ups 4.7kΩ
+ *
+ * @note     For detailed documentation with examples, visit:
+ *           https://github.com/aKaReZa75/AVR_AHT20
+ ******************************************************************************
+ */
+#ifndef _aht20_usi_H_
+#define _aht20_usi_H_
+
+#include "aKaReZa.h"
+
+
+/* ============================================================================
+ *                         USI PINS
+ * ============================================================================ */
+#ifndef __AHT20_USI_PORT
+    #define __AHT20_USI_PORT    PORTB    /**< USI port output register */
+    #define __AHT20_USI_DDR     DDRB     /**< USI port direction register */
+    #define __AHT20_USI_PIN     PINB     /**< USI port input register */
+    #define __AHT20_USI_SDA     0        /**< SDA = DI/SDA (PB0 on ATtiny85) */
+    #define __AHT20_USI_SCL     2        /**< SCL = USCK/SCL (PB2 on ATtiny85) */
+#endif
+
+
+/* ============================================================================
+ *                         BUS TIMING
+ * ============================================================================ */
+#ifndef __AHT20_USI_T2
+    #define __AHT20_USI_T2      5        /**< SCL low period in us (5us + 4us ≈ 100kHz Standard Mode) */
+    #define __AHT20_USI_T4      4        /**< SCL high period in us */
+#endif
+#ifndef __AHT20_USI_STRETCH
+    #define __AHT20_USI_STRETCH 10000    /**< Longest accepted clock stretch in us (~10ms), then the transfer fails */
+#endif
+
+/**< Wire time estimate without stretching: START + STOP + 9 clocks per byte (address byte included) */
+#define __AHT20_USI_XFER_US(_Bytes)  (2 * (__AHT20_USI_T2 + __AHT20_USI_T4) + (_Bytes) * 9 * (__AHT20_USI_T2 + __AHT20_USI_T4))
+#define __AHT20_USI_FRAME_US         __AHT20_USI_XFER_US(1 + 7)  /**< Measurement read: address + 7 bytes (666us with the default timing) */
+
+
+/* ============================================================================
+ *                         USI STATUS PRESETS
+ * ============================================================================ */
+#define __AHT20_USI_SR_8BIT ((1 << USISIF) | (1 << USIOIF) | (1 << USIPF) | (1 << USIDC) | (0x0 << USICNT0))  /**< Clear flags, count 16 edges (8 bits) */
+#define __AHT20_USI_SR_1BIT ((1 << USISIF) | (1 << USIOIF) | (1 << USIPF) | (1 << USIDC) | (0xE << USICNT0))  /**< Clear flags, count 2 edges (ACK bit) */
+
+
+/* ============================================================================
+ *                         FUNCTION PROTOTYPES
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Configure SDA/SCL and USI for two-wire master mode
+ * @note Call once instead of i2c_Init()
+ * ------------------------------------------------------- */
+void aht20_usiInit(void);
+
+/* -------------------------------------------------------
+ * @brief Write bytes to a slave
+ * @param _Add: 7-bit slave address
+ * @param _Data: Bytes to send
+ * @param _Len: Number of bytes
+ * @retval true: All bytes acknowledged, false: NACK received or clock stretch timeout
+ * ------------------------------------------------------- */
+bool aht20_usiWrite(uint8_t _Add, const uint8_t* _Data, uint8_t _Len);
+
+/* -------------------------------------------------------
+ * @brief Read bytes from a slave
+ * @param _Add: 7-bit slave address
+ * @param _Data: Destination buffer
+ * @param _Len: Number of bytes (last one is NACKed)
+ * @retval true: Address acknowledged, false: NACK received or clock stretch timeout
+ * ------------------------------------------------------- */
+bool aht20_usiRead(uint8_t _Add, uint8_t* _Data, uint8_t _Len);
+
+/* -------------------------------------------------------
+ * @brief Write a command, then read the answer after a repeated START
+ * @param _Add: 7-bit slave address
+ * @param _Cmd: Command bytes
+ * @param _CmdLen: Number of command bytes
+ * @param _Data: Destination buffer
+ * @param _Len: Number of bytes to read
+ * @retval true: Success, false: NACK received or clock stretch timeout
+ * ------------------------------------------------------- */
+bool aht20_usiReadSequential(uint8_t _Add, const uint8_t* _Cmd, uint8_t _CmdLen, uint8_t* _Data, uint8_t _Len);
+
+/* -------------------------------------------------------
+ * @brief Longest clock stretch seen since aht20_usiInit()
+ * @retval Stretch time in us (approximate, 1us poll steps)
+ * @note Compare with __AHT20_USI_T4 to see how much a slow slave adds
+ *       to __AHT20_USI_XFER_US() at the chosen bus speed
+ * ------------------------------------------------------- */
+uint16_t aht20_usiStretchMax(void);
+
+#endif /* _aht20_usi_H_ */
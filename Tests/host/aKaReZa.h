@@ -0,0 +1,89 @@
+/**
+ ******************************************************************************
+ * @file     aKaReZa.h
+ * @brief    Host stand-in for the AVR base libraries (aKaReZa.h, spi.h, i2c.h, err.h)
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     Only used by the host tests in Tests/. I/O registers are plain
+ *           variables, delays advance the simulated clock (host_Us) and
+ *           every bitSet()/bitClear() calls host_portHook() so the flash
+ *           model sees chip select edges.
+ ******************************************************************************
+ */
+#ifndef _aKaReZa_H_
+#define _aKaReZa_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/* ============================================================================
+ *                         I/O REGISTERS
+ * ============================================================================ */
+extern volatile uint8_t  PORTB, DDRB, PINB;
+extern volatile uint8_t  TCCR1A, TCCR1B;
+extern volatile uint16_t TCNT1;
+extern volatile uint8_t  USIDR, USISR, USICR;
+
+#define CS10    0
+#define CS11    1
+#define CS12    2
+#define USICNT0 0
+#define USITC   0
+#define USICLK  1
+#define USICS1  3
+#define USIDC   4
+#define USIPF   5
+#define USIWM1  5
+#define USIOIF  6
+#define USISIF  7
+
+
+/* ============================================================================
+ *                         BIT MACROS
+ * ============================================================================ */
+void host_portHook(void);                /**< Called after every port bit change */
+
+#define bitSet(_Reg, _Bit)       ((_Reg) |= (1 << (_Bit)), host_portHook())
+#define bitClear(_Reg, _Bit)     ((_Reg) &= ~(1 << (_Bit)), host_portHook())
+#define bitToggle(_Reg, _Bit)    ((_Reg) ^= (1 << (_Bit)), host_portHook())
+#define bitCheck(_Reg, _Bit)     (((_Reg) >> (_Bit)) & 1)
+#define bitCheckHigh(_Reg, _Bit) (bitCheck(_Reg, _Bit) == 1)
+#define bitCheckLow(_Reg, _Bit)  (bitCheck(_Reg, _Bit) == 0)
+
+
+/* ============================================================================
+ *                         SIMULATED TIME
+ * ============================================================================ */
+extern uint32_t host_Us;                 /**< Simulated time in microseconds */
+
+void delay_us(uint16_t _Us);
+void delay_ms(uint16_t _Ms);
+
+
+/* ============================================================================
+ *                         BUS LIBRARIES
+ * ============================================================================ */
+#define _SPI_H_
+uint8_t spi_Transfer(uint8_t _Data);     /**< Provided by the flash model */
+
+#define _I2C_H_
+void i2c_writeAddress(uint8_t _Add, uint8_t* _Data, uint8_t _Len);
+void i2c_readAdress(uint8_t _Add, uint8_t* _Data, uint8_t _Len);
+void i2c_readSequential(uint8_t _Add, uint8_t* _Cmd, uint8_t _CmdLen, uint8_t* _Data, uint8_t _Len);
+
+typedef struct
+{
+    uint8_t Poly;
+    uint8_t Init;
+    bool    refIn;
+    bool    refOut;
+    uint8_t xorOut;
+} hcrc8_T;
+
+uint8_t CRC8_Calc(const hcrc8_T* _Crc, const uint8_t* _Buf, uint16_t _Len);
+
+#endif /* _aKaReZa_H_ */
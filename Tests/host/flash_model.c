@@ -0,0 +1,221 @@
+/**
+ ******************************************************************************
+ * @file     flash_model.c
+ * @brief    Host model of a JEDEC SPI NOR flash - implementation
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     EXECUTION FLOW:
+ *           1. CS LOW:
+ *              └─> New transaction: clear byte count, address and page latch
+ *
+ *           2. spi_Transfer():
+ *              └─> Advance host_Us → Byte 0 = command (ignored and counted
+ *                  as fault while busy, except RDSR) → Bytes 1..3 = address
+ *                  → Data: READ returns array bytes, PP fills the page latch,
+ *                  RDSR returns WIP/WEL
+ *
+ *           3. CS HIGH:
+ *              └─> PP: AND latch into the page → WIP for __FLASH_T_PP
+ *              └─> SE: Sector to 0xFF → WIP for __FLASH_T_SE
+ ******************************************************************************
+ */
+
+#include "flash_model.h"
+#include "aKaReZa.h"
+#include <string.h>
+
+
+#define __FLASH_CMD_WREN    0x06
+#define __FLASH_CMD_RDSR    0x05
+#define __FLASH_CMD_READ    0x03
+#define __FLASH_CMD_PP      0x02
+#define __FLASH_CMD_SE      0x20
+
+uint8_t       flash_Mem[__FLASH_SIZE];
+Flash_Stats_T flash_Stats;
+
+static bool     _flashSelected = false;                    /**< CS LOW */
+static bool     _flashIgnored = false;                     /**< Command arrived while busy */
+static bool     _flashWel = false;                         /**< Write enable latch */
+static uint8_t  _flashCmd;                                 /**< Command of this transaction */
+static uint32_t _flashAddr;                                /**< 24-bit address of this transaction */
+static uint32_t _flashCount;                               /**< Bytes in this transaction */
+static uint32_t _flashBusyUntil = 0;                       /**< host_Us when WIP clears */
+static uint8_t  _flashLatch[__FLASH_PAGE];                 /**< Page program data */
+static bool     _flashLatched[__FLASH_PAGE];               /**< Latch byte written */
+
+
+/* ============================================================================
+ *                       HELPERS
+ * ============================================================================ */
+
+static void _flash_Program(void)
+{
+    uint32_t _Page = (_flashAddr % __FLASH_SIZE) / __FLASH_PAGE;
+
+    for(uint16_t _Idx = 0; _Idx < __FLASH_PAGE; _Idx++)
+    {
+        uint8_t* _Cell = &flash_Mem[_Page * __FLASH_PAGE + _Idx];
+
+        if(!_flashLatched[_Idx])
+        {
+            continue;
+        };
+        if((*_Cell & _flashLatch[_Idx]) != _flashLatch[_Idx])  /**< NOR can only clear bits */
+        {
+            flash_Stats.Faults++;
+        };
+        *_Cell &= _flashLatch[_Idx];
+    };
+
+    flash_Stats.Programs++;
+    if(++flash_Stats.PagePrograms[_Page] > flash_Stats.PageProgramsMax)
+    {
+        flash_Stats.PageProgramsMax = flash_Stats.PagePrograms[_Page];
+    };
+    _flashBusyUntil = host_Us + __FLASH_T_PP;
+};
+
+static void _flash_Erase(void)
+{
+    uint32_t _Sector = (_flashAddr % __FLASH_SIZE) / __FLASH_SECTOR;
+    uint16_t _Pages = __FLASH_SECTOR / __FLASH_PAGE;
+
+    memset(&flash_Mem[_Sector * __FLASH_SECTOR], 0xFF, __FLASH_SECTOR);
+    memset(&flash_Stats.PagePrograms[_Sector * _Pages], 0, _Pages);
+
+    flash_Stats.Erases++;
+    flash_Stats.SectorErases[_Sector]++;
+    _flashBusyUntil = host_Us + __FLASH_T_SE;
+};
+
+
+/* ============================================================================
+ *                       PUBLIC FUNCTIONS
+ * ============================================================================ */
+
+void flash_Reset(uint8_t _Fill)
+{
+    memset(flash_Mem, _Fill, sizeof(flash_Mem));
+    memset(&flash_Stats, 0, sizeof(flash_Stats));
+    _flashSelected = false;
+    _flashWel = false;
+    _flashBusyUntil = host_Us;
+};
+
+bool flash_isBusy(void)
+{
+    return (int32_t)(_flashBusyUntil - host_Us) > 0;
+};
+
+void flash_Select(bool _High)
+{
+    if(!_High)                                             /**< Start of a transaction */
+    {
+        _flashSelected = true;
+        _flashIgnored = false;
+        _flashCount = 0;
+        _flashAddr = 0;
+        memset(_flashLatched, 0, sizeof(_flashLatched));
+        return;
+    };
+
+    if(!_flashSelected)
+    {
+        return;
+    };
+    _flashSelected = false;
+
+    if(_flashIgnored || (_flashCount == 0))
+    {
+        return;
+    };
+
+    switch(_flashCmd)
+    {
+        case __FLASH_CMD_WREN:
+            _flashWel = true;
+            break;
+
+        case __FLASH_CMD_READ:
+            flash_Stats.Reads++;
+            break;
+
+        case __FLASH_CMD_PP:
+        case __FLASH_CMD_SE:
+            if(!_flashWel || (_flashCount < 4))
+            {
+                flash_Stats.Faults++;
+                break;
+            };
+            if(_flashCmd == __FLASH_CMD_PP)
+            {
+                _flash_Program();
+            }
+            else
+            {
+                _flash_Erase();
+            };
+            _flashWel = false;
+            break;
+
+        default:
+            break;
+    };
+};
+
+uint8_t spi_Transfer(uint8_t _Data)
+{
+    uint8_t  _Out = 0xFF;
+    uint32_t _Pos = _flashCount++;
+
+    host_Us += __FLASH_T_BYTE;
+    if(!_flashSelected || _flashIgnored)
+    {
+        return _Out;
+    };
+
+    if(_Pos == 0)
+    {
+        _flashCmd = _Data;
+        if(flash_isBusy() && (_flashCmd != __FLASH_CMD_RDSR))  /**< Chip ignores everything but RDSR while busy */
+        {
+            flash_Stats.Faults++;
+            _flashIgnored = true;
+        };
+        return _Out;
+    };
+
+    if(_flashCmd == __FLASH_CMD_RDSR)
+    {
+        if(flash_isBusy())
+        {
+            flash_Stats.StallUs += 2 * __FLASH_T_BYTE;     /**< Command + status byte */
+            return 0x01 | (_flashWel ? 0x02 : 0x00);
+        };
+        return _flashWel ? 0x02 : 0x00;
+    };
+
+    if(_Pos <= 3)                                          /**< Address, MSB first */
+    {
+        _flashAddr = (_flashAddr << 8) | _Data;
+        return _Out;
+    };
+
+    if(_flashCmd == __FLASH_CMD_READ)
+    {
+        _Out = flash_Mem[(_flashAddr + _Pos - 4) % __FLASH_SIZE];
+    }
+    else if(_flashCmd == __FLASH_CMD_PP)
+    {
+        uint8_t _Col = (uint8_t)(_flashAddr + _Pos - 4);   /**< Wraps inside the page like the real chip */
+
+        _flashLatch[_Col] = _Data;
+        _flashLatched[_Col] = true;
+        flash_Stats.ProgBytes++;
+    };
+
+    return _Out;
+};
@@ -0,0 +1,83 @@
+/**
+ ******************************************************************************
+ * @file     flash_model.h
+ * @brief    Host model of a JEDEC SPI NOR flash (W25Q80 class) for the log tests
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     Behaves like the chip on the SPI bus:
+ *           - Commands WREN, RDSR, READ, PP (256-byte page wrap) and SE (4KB)
+ *           - PP and SE need WEL, run in the background for their datasheet
+ *             time and set WIP meanwhile; every SPI byte takes __FLASH_T_BYTE
+ *           - Programming can only clear bits; setting a 0 bit is a fault
+ *
+ * @note     Counters for the tests:
+ *           - Endurance: erases per sector, programs per page since its erase
+ *           - Traffic: program/erase/read commands, programmed bytes
+ *           - Stall: time the MCU spent polling WIP while the chip was busy
+ *           - Faults: commands while busy, PP/SE without WEL, 0 → 1 programs
+ ******************************************************************************
+ */
+#ifndef _flash_model_H_
+#define _flash_model_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/* ============================================================================
+ *                         CHIP GEOMETRY AND TIMING
+ * ============================================================================ */
+#define __FLASH_SIZE        0x100000UL   /**< 1MB (W25Q80) */
+#define __FLASH_PAGE        256          /**< Program granularity */
+#define __FLASH_SECTOR      4096UL       /**< Erase granularity */
+#define __FLASH_PAGES       (__FLASH_SIZE / __FLASH_PAGE)
+#define __FLASH_SECTORS     (__FLASH_SIZE / __FLASH_SECTOR)
+
+#define __FLASH_T_BYTE      1            /**< us per SPI byte (8MHz SCK) */
+#define __FLASH_T_PP        700          /**< Page program, typical (us) */
+#define __FLASH_T_SE        45000        /**< Sector erase, typical (us) */
+
+
+/* ============================================================================
+ *                         COUNTERS
+ * ============================================================================ */
+typedef struct
+{
+    uint32_t Programs;                   /**< Page program commands */
+    uint32_t ProgBytes;                  /**< Bytes shifted in by page programs */
+    uint32_t Erases;                     /**< Sector erase commands */
+    uint32_t Reads;                      /**< Read commands */
+    uint32_t StallUs;                    /**< Time spent polling WIP while busy */
+    uint32_t Faults;                     /**< Protocol or NOR violations */
+    uint16_t SectorErases[__FLASH_SECTORS];  /**< Endurance: erases per sector */
+    uint8_t  PagePrograms[__FLASH_PAGES];    /**< Programs per page since its sector was erased */
+    uint8_t  PageProgramsMax;            /**< Highest PagePrograms value seen (NOP needed) */
+} Flash_Stats_T;
+
+extern uint8_t       flash_Mem[__FLASH_SIZE];  /**< Array content */
+extern Flash_Stats_T flash_Stats;
+
+
+/* ============================================================================
+ *                         FUNCTION PROTOTYPES
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Fill the array with _Fill, clear counters and chip state
+ * ------------------------------------------------------- */
+void flash_Reset(uint8_t _Fill);
+
+/* -------------------------------------------------------
+ * @brief Chip select level changed (called from host_portHook())
+ * @param _High: true = deselected (command executes), false = selected
+ * ------------------------------------------------------- */
+void flash_Select(bool _High);
+
+/* -------------------------------------------------------
+ * @brief Program or erase still running
+ * ------------------------------------------------------- */
+bool flash_isBusy(void);
+
+#endif /* _flash_model_H_ */
@@ -0,0 +1,73 @@
+/**
+ ******************************************************************************
+ * @file     host.c
+ * @brief    Host stand-in for the AVR registers and delays used by the tests
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ ******************************************************************************
+ */
+
+#include "aht20_log.h"
+#include "flash_model.h"
+
+
+volatile uint8_t  PORTB, DDRB, PINB;
+volatile uint8_t  TCCR1A, TCCR1B;
+volatile uint16_t TCNT1;
+volatile uint8_t  USIDR, USISR, USICR;
+
+uint32_t host_Us = 0;
+
+static uint8_t _hostCS = 0;                                /**< Last seen flash CS level */
+
+
+void delay_us(uint16_t _Us)
+{
+    host_Us += _Us;
+};
+
+void delay_ms(uint16_t _Ms)
+{
+    host_Us += 1000UL * _Ms;
+};
+
+/* -------------------------------------------------------
+ * @brief Empty I2C bus: writes vanish, reads return 0xFF (no sensor)
+ * ------------------------------------------------------- */
+void i2c_writeAddress(uint8_t _Add, uint8_t* _Data, uint8_t _Len)
+{
+    (void)_Add;
+    (void)_Data;
+    (void)_Len;
+};
+
+void i2c_readAdress(uint8_t _Add, uint8_t* _Data, uint8_t _Len)
+{
+    (void)_Add;
+    while(_Len--)
+    {
+        *_Data++ = 0xFF;
+    };
+};
+
+void i2c_readSequential(uint8_t _Add, uint8_t* _Cmd, uint8_t _CmdLen, uint8_t* _Data, uint8_t _Len)
+{
+    (void)_Cmd;
+    (void)_CmdLen;
+    i2c_readAdress(_Add, _Data, _Len);
+};
+
+/* -------------------------------------------------------
+ * @brief Forward flash chip select edges to the flash model
+ * ------------------------------------------------------- */
+void host_portHook(void)
+{
+    uint8_t _CS = bitCheck(__AHT20_LOG_CS_PORT, __AHT20_LOG_CS_PIN);
+
+    if(_CS != _hostCS)
+    {
+        _hostCS = _CS;
+        flash_Select(_CS != 0);
+    };
+};
@@ -0,0 +1,212 @@
+/**
+ ******************************************************************************
+ * @file     test_aht20.c
+ * @brief    Host tests of the sample conversion in aht20.c (__AHT20_LITE build)
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     Built with __AHT20_LITE = 1, __AHT20_CALIB = 1 and __AHT20_DECODE = 1.
+ *
+ * @note     TESTS:
+ *           - Unpack      : Integer conversion of raw range ends and mid-scale
+ *           - Calibration : Gain/offset applied, results clamped to the sensor
+ *                           range instead of wrapping (negative offset near 0%RH)
+ *           - Frames      : aht20_checkFrame() / aht20_decodeFrames() on good frames and
+ *                           frames with BUSY set, CAL clear or a bad CRC; values
+ *                           match aht20_Unpack() for the same raw data
+ ******************************************************************************
+ */
+
+#include "aht20.h"
+#include <stdio.h>
+
+
+static uint32_t _testFailed = 0;
+
+#define CHECK(_Cond)                                                            \
+    do                                                                          \
+    {                                                                           \
+        if(!(_Cond))                                                            \
+        {                                                                       \
+            printf("  FAIL line %d: %s\n", __LINE__, #_Cond);                   \
+            _testFailed++;                                                      \
+        };                                                                      \
+    } while(0)
+
+
+/* ============================================================================
+ *                       HELPERS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Build 5 packed bytes from 20-bit raw humidity and temperature
+ * ------------------------------------------------------- */
+static void _test_Packed(uint32_t _Humi, uint32_t _Temp, uint8_t* _Packed)
+{
+    _Packed[0] = (uint8_t)(_Humi >> 12);
+    _Packed[1] = (uint8_t)(_Humi >> 4);
+    _Packed[2] = (uint8_t)((_Humi << 4) | ((_Temp >> 16) & 0x0F));
+    _Packed[3] = (uint8_t)(_Temp >> 8);
+    _Packed[4] = (uint8_t)(_Temp);
+};
+
+/* -------------------------------------------------------
+ * @brief CRC-8 of the AHT20 (poly 0x31, init 0xFF), written independently of the driver
+ * ------------------------------------------------------- */
+static uint8_t _test_CRC8(const uint8_t* _Buf, uint8_t _Len)
+{
+    uint8_t _Crc = 0xFF;
+
+    while(_Len--)
+    {
+        _Crc ^= *_Buf++;
+        for(uint8_t _Bit = 0; _Bit < 8; _Bit++)
+        {
+            _Crc = (_Crc & 0x80) ? (uint8_t)((_Crc << 1) ^ 0x31) : (uint8_t)(_Crc << 1);
+        };
+    };
+    return _Crc;
+};
+
+/* -------------------------------------------------------
+ * @brief Build a 7-byte sensor frame with a matching CRC
+ * ------------------------------------------------------- */
+static void _test_Frame(uint8_t _Status, uint32_t _Humi, uint32_t _Temp, uint8_t* _Frame)
+{
+    _Frame[0] = _Status;
+    _test_Packed(_Humi, _Temp, &_Frame[1]);
+    _Frame[__AHT20_FRAME_SIZE - 1] = _test_CRC8(_Frame, __AHT20_FRAME_SIZE - 1);
+};
+
+static void _test_Unpack(uint32_t _Humi, uint32_t _Temp, AHT20_Data_T* _Data)
+{
+    uint8_t _Packed[__AHT20_PACKED_SIZE];
+
+    _test_Packed(_Humi, _Temp, _Packed);
+    aht20_Unpack(_Packed, _Data);
+};
+
+static void _test_Calib(int16_t _TempOffset, int16_t _HumiOffset, uint16_t _TempGain, uint16_t _HumiGain)
+{
+    AHT20_Calib_T _Calib =
+    {
+        .TempOffset = _TempOffset,
+        .HumiOffset = _HumiOffset,
+        .TempGain = _TempGain,
+        .HumiGain = _HumiGain
+    };
+
+    aht20_setCalib(&_Calib);
+};
+
+
+/* ============================================================================
+ *                       TESTS
+ * ============================================================================ */
+
+static void _test_Conversion(void)
+{
+    AHT20_Data_T _Data;
+
+    printf("unpack\n");
+    _test_Calib(0, 0, __AHT20_CALIB_GAIN_ONE, __AHT20_CALIB_GAIN_ONE);
+
+    _test_Unpack(0, 0, &_Data);
+    CHECK((_Data.Humidity == 0) && (_Data.Temp == -5000));
+    _test_Unpack(0x80000, 0x80000, &_Data);                /**< Mid-scale: 50.00%RH, 50.00°C */
+    CHECK((_Data.Humidity == 5000) && (_Data.Temp == 5000));
+    _test_Unpack(0xFFFFF, 0xFFFFF, &_Data);
+    CHECK((_Data.Humidity == 9999) && (_Data.Temp == 14999));
+    _test_Unpack(5243, 0x80000, &_Data);                   /**< 0.50%RH */
+    CHECK(_Data.Humidity == 50);
+};
+
+static void _test_Calibration(void)
+{
+    AHT20_Data_T _Data;
+
+    printf("calibration\n");
+
+    _test_Calib(-50, -120, __AHT20_CALIB_GAIN_ONE, __AHT20_CALIB_GAIN_ONE);
+    _test_Unpack(0x80000, 0x80000, &_Data);
+    CHECK((_Data.Humidity == 4880) && (_Data.Temp == 4950));
+    _test_Unpack(5243, 0, &_Data);                         /**< 0.50%RH - 1.20%RH, -50.00°C - 0.50°C */
+    CHECK(_Data.Humidity == 0);                            /**< Not 65466 */
+    CHECK(_Data.Temp == -5000);
+
+    _test_Calib(100, 200, __AHT20_CALIB_GAIN_ONE, __AHT20_CALIB_GAIN_ONE);
+    _test_Unpack(0xFFFFF, 0xFFFFF, &_Data);
+    CHECK((_Data.Humidity == 10000) && (_Data.Temp == 15000));
+
+    _test_Calib(0, 0, 2 * __AHT20_CALIB_GAIN_ONE, 2 * __AHT20_CALIB_GAIN_ONE);  /**< Gain 2.0 */
+    _test_Unpack(0x80000, 0x80000, &_Data);
+    CHECK((_Data.Humidity == 10000) && (_Data.Temp == 10000));
+    _test_Unpack(0x10000, 0x10000, &_Data);                /**< 6.25%RH, -37.50°C */
+    CHECK((_Data.Humidity == 1250) && (_Data.Temp == -5000));
+
+    _test_Calib(0, 0, __AHT20_CALIB_GAIN_ONE, __AHT20_CALIB_GAIN_ONE);
+};
+
+
+static void _test_Frames(void)
+{
+    static const uint32_t _Raw[][2] =                      /**< Humidity, temperature */
+    {
+        {0x00000, 0x00000}, {0x80000, 0x80000}, {0xFFFFF, 0xFFFFF}, {0x12345, 0x6789A},
+        {0x6A5F3, 0x5C28F}, {0x80000, 0x80000}, {0x80000, 0x80000}, {0x80000, 0x80000}
+    };
+    uint8_t      _Frames[8][__AHT20_FRAME_SIZE];
+    int16_t      _Temp[8];
+    uint16_t     _Humi[8];
+    AHT20_Res_T  _Res[8];
+    AHT20_Data_T _Data;
+
+    printf("frames\n");
+    _test_Calib(0, 0, __AHT20_CALIB_GAIN_ONE, __AHT20_CALIB_GAIN_ONE);  /**< decodeFrames() applies no calibration */
+
+    for(uint8_t _Idx = 0; _Idx < 8; _Idx++)
+    {
+        _test_Frame(0x18, _Raw[_Idx][0], _Raw[_Idx][1], _Frames[_Idx]);  /**< CAL set, idle */
+    };
+    _test_Frame(0x98, 0x80000, 0x80000, _Frames[5]);       /**< BUSY set */
+    _test_Frame(0x10, 0x80000, 0x80000, _Frames[6]);       /**< CAL clear */
+    _Frames[7][__AHT20_FRAME_SIZE - 1] ^= 0x01;            /**< Bad CRC */
+
+    CHECK(aht20_checkFrame(_Frames[0]) == AHT20_Res_OK);
+    CHECK(aht20_checkFrame(_Frames[5]) == AHT20_Res_Busy);
+    CHECK(aht20_checkFrame(_Frames[6]) == AHT20_Res_ERR);
+    CHECK(aht20_checkFrame(_Frames[7]) == AHT20_Res_ERR);
+
+    CHECK(aht20_decodeFrames(&_Frames[0][0], 8, _Temp, _Humi, _Res) == 5);
+    for(uint8_t _Idx = 0; _Idx < 5; _Idx++)
+    {
+        aht20_Unpack(&_Frames[_Idx][1], &_Data);           /**< Same raw bytes through the single-sample path */
+        CHECK(_Res[_Idx] == AHT20_Res_OK);
+        CHECK((_Temp[_Idx] == _Data.Temp) && (_Humi[_Idx] == _Data.Humidity));
+    };
+    CHECK((_Res[5] == AHT20_Res_Busy) && (_Res[6] == AHT20_Res_ERR) && (_Res[7] == AHT20_Res_ERR));
+    for(uint8_t _Idx = 5; _Idx < 8; _Idx++)
+    {
+        CHECK((_Temp[_Idx] == 0) && (_Humi[_Idx] == 0));   /**< Invalid frames give 0 */
+    };
+
+    CHECK(aht20_decodeFrames(&_Frames[0][0], 8, _Temp, _Humi, NULL) == 5);  /**< Status array is optional */
+};
+
+
+/* ============================================================================
+ *                       MAIN
+ * ============================================================================ */
+
+int main(void)
+{
+    printf("aht20\n");
+
+    _test_Conversion();
+    _test_Calibration();
+    _test_Frames();
+
+    printf("%s (%lu failed checks)\n", _testFailed ? "FAILED" : "PASSED", (unsigned long)_testFailed);
+    return _testFailed ? 1 : 0;
+};
@@ -0,0 +1,244 @@
+/**
+ ******************************************************************************
+ * @file     test_fifo.c
+ * @brief    Host tests of the fan-out ring and its delivery filter (aht20_fifo.c)
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     TESTS:
+ *           - Wrap    : Head and Tail run over 255 → 0, every sample arrives in order
+ *           - Overrun : A reader lapped by the producer counts Lost and resumes
+ *                       at Head - (__AHT20_FIFO_SIZE - 1)
+ *           - Readers : Two readers at different positions see their own samples
+ *           - Filter  : Dead-band drops small changes, MinGap limits the rate,
+ *                       a batch stops at _Max and the rest stays queued
+ ******************************************************************************
+ */
+
+#include "aht20_fifo.h"
+#include <stdio.h>
+
+
+static uint32_t _testFailed = 0;
+
+#define CHECK(_Cond)                                                            \
+    do                                                                          \
+    {                                                                           \
+        if(!(_Cond))                                                            \
+        {                                                                       \
+            printf("  FAIL line %d: %s\n", __LINE__, #_Cond);                   \
+            _testFailed++;                                                      \
+        };                                                                      \
+    } while(0)
+
+
+/* ============================================================================
+ *                       HELPERS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Packed sample carrying its push number in the humidity bytes
+ * ------------------------------------------------------- */
+static void _test_Sample(uint16_t _Num, uint8_t* _Packed)
+{
+    _Packed[0] = (uint8_t)(_Num >> 8);
+    _Packed[1] = (uint8_t)(_Num);
+    _Packed[2] = 0x06;
+    _Packed[3] = 0x66;
+    _Packed[4] = 0x60;
+};
+
+static uint16_t _test_Number(const uint8_t* _Packed)
+{
+    return ((uint16_t)_Packed[0] << 8) | _Packed[1];
+};
+
+/* -------------------------------------------------------
+ * @brief Push one sample given as Raw16 humidity and temperature
+ * ------------------------------------------------------- */
+static void _test_PushRaw16(AHT20_Fanout_T* _Ring, uint16_t _Humi, uint16_t _Temp)
+{
+    uint8_t _Packed[__AHT20_PACKED_SIZE];
+
+    _Packed[0] = (uint8_t)(_Humi >> 8);
+    _Packed[1] = (uint8_t)(_Humi);
+    _Packed[2] = (uint8_t)(_Temp >> 12);
+    _Packed[3] = (uint8_t)(_Temp >> 4);
+    _Packed[4] = (uint8_t)(_Temp << 4);
+    aht20_fanoutPush(_Ring, _Packed);
+};
+
+static void _test_Push(AHT20_Fanout_T* _Ring, uint16_t _From, uint16_t _To)
+{
+    uint8_t _Packed[__AHT20_PACKED_SIZE];
+
+    for(uint16_t _Num = _From; _Num < _To; _Num++)
+    {
+        _test_Sample(_Num, _Packed);
+        aht20_fanoutPush(_Ring, _Packed);
+    };
+};
+
+
+/* ============================================================================
+ *                       TESTS
+ * ============================================================================ */
+
+static void _test_Wrap(void)
+{
+    AHT20_Fanout_T _Ring;
+    AHT20_Reader_T _Reader;
+    uint8_t        _Packed[__AHT20_PACKED_SIZE];
+    uint16_t       _Next = 0, _Got = 0;
+
+    printf("wrap\n");
+    aht20_fanoutInit(&_Ring);
+    aht20_fanoutJoin(&_Ring, &_Reader);
+
+    for(uint16_t _Num = 0; _Num < 700; _Num += 3)          /**< Head passes 255 → 0 twice */
+    {
+        _test_Push(&_Ring, _Num, _Num + 3);
+        while(aht20_fanoutPop(&_Ring, &_Reader, _Packed))
+        {
+            CHECK(_test_Number(_Packed) == _Next);
+            _Next++;
+            _Got++;
+        };
+    };
+
+    CHECK(_Got == 702);
+    CHECK(_Reader.Lost == 0);
+    CHECK(_Reader.Tail == _Ring.Head);
+};
+
+static void _test_Overrun(void)
+{
+    AHT20_Fanout_T _Ring;
+    AHT20_Reader_T _Reader;
+    uint8_t        _Packed[__AHT20_PACKED_SIZE];
+    uint16_t       _Pushed = 250 + __AHT20_FIFO_SIZE + 5;
+
+    printf("overrun\n");
+    aht20_fanoutInit(&_Ring);
+    _test_Push(&_Ring, 0, 250);                            /**< Start close to the 8-bit wrap */
+    aht20_fanoutJoin(&_Ring, &_Reader);
+    _test_Push(&_Ring, 250, _Pushed);                      /**< Lapped by 6 samples */
+
+    CHECK(aht20_fanoutPop(&_Ring, &_Reader, _Packed));
+    CHECK(_Reader.Lost == 6);
+    CHECK(_test_Number(_Packed) == _Pushed - (__AHT20_FIFO_SIZE - 1));  /**< Oldest slot still valid */
+
+    for(uint16_t _Num = _Pushed - (__AHT20_FIFO_SIZE - 2); _Num < _Pushed; _Num++)
+    {
+        CHECK(aht20_fanoutPop(&_Ring, &_Reader, _Packed));
+        CHECK(_test_Number(_Packed) == _Num);
+    };
+    CHECK(!aht20_fanoutPop(&_Ring, &_Reader, _Packed));
+    CHECK(_Reader.Lost == 6);
+
+    /* Overwritten while peeked: Release reports it, the data is discarded */
+    CHECK(aht20_fanoutPeek(&_Ring, &_Reader) == NULL);
+    _test_Push(&_Ring, _Pushed, _Pushed + 1);
+    CHECK(aht20_fanoutPeek(&_Ring, &_Reader) != NULL);
+    _test_Push(&_Ring, _Pushed + 1, _Pushed + 1 + __AHT20_FIFO_SIZE);
+    CHECK(!aht20_fanoutRelease(&_Ring, &_Reader));
+    CHECK(_Reader.Lost == 7);
+};
+
+static void _test_Readers(void)
+{
+    AHT20_Fanout_T _Ring;
+    AHT20_Reader_T _Fast, _Slow;
+    uint8_t        _Packed[__AHT20_PACKED_SIZE];
+
+    printf("two readers\n");
+    aht20_fanoutInit(&_Ring);
+    aht20_fanoutJoin(&_Ring, &_Slow);
+    _test_Push(&_Ring, 0, 3);
+    aht20_fanoutJoin(&_Ring, &_Fast);                      /**< Joins after 3 samples */
+    _test_Push(&_Ring, 3, 5);
+
+    CHECK(aht20_fanoutPop(&_Ring, &_Fast, _Packed) && (_test_Number(_Packed) == 3));
+    CHECK(aht20_fanoutPop(&_Ring, &_Fast, _Packed) && (_test_Number(_Packed) == 4));
+    CHECK(!aht20_fanoutPop(&_Ring, &_Fast, _Packed));
+
+    CHECK(aht20_fanoutPop(&_Ring, &_Slow, _Packed) && (_test_Number(_Packed) == 0));  /**< Own cursor, from its join */
+    CHECK(aht20_fanoutPop(&_Ring, &_Slow, _Packed) && (_test_Number(_Packed) == 1));
+
+    for(uint16_t _Num = 5; _Num < 5 + __AHT20_FIFO_SIZE; _Num++)  /**< Slow one falls behind, fast one keeps up */
+    {
+        _test_Push(&_Ring, _Num, _Num + 1);
+        CHECK(aht20_fanoutPop(&_Ring, &_Fast, _Packed) && (_test_Number(_Packed) == _Num));
+    };
+    CHECK(aht20_fanoutPop(&_Ring, &_Slow, _Packed) && (_test_Number(_Packed) == 6));
+    CHECK((_Fast.Lost == 0) && (_Slow.Lost == 4));         /**< 2, 3, 4 and 5 were overwritten */
+};
+
+
+static void _test_Filter(void)
+{
+    AHT20_Fanout_T _Ring;
+    AHT20_Reader_T _Reader;
+    AHT20_Filter_T _Filter;
+    uint8_t        _Batch[8 * __AHT20_PACKED_SIZE];
+
+    printf("filter\n");
+    aht20_fanoutInit(&_Ring);
+    aht20_fanoutJoin(&_Ring, &_Reader);
+
+    /* Dead-band: 1.00%RH = 655 Raw16, 1.00°C = 327 Raw16 */
+    aht20_filterInit(&_Filter, 100, 100, 0);
+    _test_PushRaw16(&_Ring, 30000, 20000);                 /**< First sample always passes */
+    _test_PushRaw16(&_Ring, 30300, 20100);                 /**< Inside both bands */
+    _test_PushRaw16(&_Ring, 29400, 20300);                 /**< Still inside: measured from the last delivered sample */
+    _test_PushRaw16(&_Ring, 30700, 20000);                 /**< Humidity moved 700 */
+    _test_PushRaw16(&_Ring, 30700, 19600);                 /**< Temperature moved 400 */
+    CHECK(aht20_fanoutPopBatch(&_Ring, &_Reader, &_Filter, _Batch, 8) == 3);
+    CHECK(__AHT20_HUMI16(&_Batch[0]) == 30000);
+    CHECK(__AHT20_HUMI16(&_Batch[__AHT20_PACKED_SIZE]) == 30700);
+    CHECK(__AHT20_TEMP16(&_Batch[__AHT20_PACKED_SIZE]) == 20000);
+    CHECK(__AHT20_TEMP16(&_Batch[2 * __AHT20_PACKED_SIZE]) == 19600);
+    CHECK(aht20_fanoutPopBatch(&_Ring, &_Reader, &_Filter, _Batch, 8) == 0);  /**< Dropped samples are consumed */
+
+    /* Rate limit: every change passes the band, MinGap = 2 drops two after each delivery */
+    aht20_filterInit(&_Filter, 0, 0, 2);
+    for(uint16_t _Idx = 0; _Idx < 7; _Idx++)
+    {
+        _test_PushRaw16(&_Ring, (uint16_t)(1000 + _Idx), 20000);
+    };
+    CHECK(aht20_fanoutPopBatch(&_Ring, &_Reader, &_Filter, _Batch, 8) == 3);
+    CHECK(__AHT20_HUMI16(&_Batch[0]) == 1000);
+    CHECK(__AHT20_HUMI16(&_Batch[__AHT20_PACKED_SIZE]) == 1003);
+    CHECK(__AHT20_HUMI16(&_Batch[2 * __AHT20_PACKED_SIZE]) == 1006);
+
+    /* Batch size: stops at _Max, the rest is read by the next call */
+    for(uint16_t _Idx = 0; _Idx < 6; _Idx++)
+    {
+        _test_PushRaw16(&_Ring, (uint16_t)(2000 + _Idx), 20000);
+    };
+    CHECK(aht20_fanoutPopBatch(&_Ring, &_Reader, NULL, _Batch, 4) == 4);
+    CHECK(__AHT20_HUMI16(&_Batch[3 * __AHT20_PACKED_SIZE]) == 2003);
+    CHECK(aht20_fanoutPopBatch(&_Ring, &_Reader, NULL, _Batch, 4) == 2);
+    CHECK(__AHT20_HUMI16(&_Batch[0]) == 2004);
+    CHECK(aht20_fanoutPopBatch(&_Ring, &_Reader, NULL, _Batch, 4) == 0);
+    CHECK(_Reader.Lost == 0);
+};
+
+
+/* ============================================================================
+ *                       MAIN
+ * ============================================================================ */
+
+int main(void)
+{
+    printf("aht20_fifo, __AHT20_FIFO_SIZE = %d\n", __AHT20_FIFO_SIZE);
+
+    _test_Wrap();
+    _test_Overrun();
+    _test_Readers();
+    _test_Filter();
+
+    printf("%s (%lu failed checks)\n", _testFailed ? "FAILED" : "PASSED", (unsigned long)_testFailed);
+    return _testFailed ? 1 : 0;
+};
@@ -0,0 +1,323 @@
+/**
+ ******************************************************************************
+ * @file     test_log.c
+ * @brief    Host tests of the SPI NOR flash log (aht20_log.c) on the flash model
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     Build and run with "make -C Tests". The binary is built twice:
+ *           full-page writes (__AHT20_LOG_FLUSH = 0) and group commit
+ *           (__AHT20_LOG_FLUSH = 8).
+ *
+ * @note     TESTS:
+ *           - Readback   : Every appended sample reads back, no stall with aht20_logService()
+ *           - Stall      : Without aht20_logService() the page program waits for the erase
+ *           - Dirty chip : Log starts on a chip that was never erased, oldest record stays 0
+ *           - Wrap       : Ring wrap, retention window, export, endurance counters
+ *           - Recovery   : Reset loses only the unflushed records, logging continues
+ *           - Search     : aht20_logFindAbove() hits and zone map pruning
+ ******************************************************************************
+ */
+
+#include "aht20_log.h"
+#include "flash_model.h"
+#include <stdio.h>
+
+
+#define __TEST_RECS   __AHT20_LOG_PAGE_RECS    /**< Records per page */
+
+static uint32_t _testFailed = 0;
+
+#define CHECK(_Cond)                                                            \
+    do                                                                          \
+    {                                                                           \
+        if(!(_Cond))                                                            \
+        {                                                                       \
+            printf("  FAIL line %d: %s\n", __LINE__, #_Cond);                   \
+            _testFailed++;                                                      \
+        };                                                                      \
+    } while(0)
+
+
+/* ============================================================================
+ *                       HELPERS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Sample carrying its own 24-bit index (never all 0xFF)
+ * ------------------------------------------------------- */
+static void _test_Sample(uint32_t _Idx, uint8_t* _Packed)
+{
+    _Packed[0] = _Idx >> 16;
+    _Packed[1] = _Idx >> 8;
+    _Packed[2] = _Idx;
+    _Packed[3] = 0x5A;
+    _Packed[4] = 0xA5;
+};
+
+static bool _test_isSample(uint32_t _Idx, const uint8_t* _Packed)
+{
+    uint8_t _Expect[__AHT20_PACKED_SIZE];
+
+    _test_Sample(_Idx, _Expect);
+    for(uint8_t _Byte = 0; _Byte < __AHT20_PACKED_SIZE; _Byte++)
+    {
+        if(_Packed[_Byte] != _Expect[_Byte])
+        {
+            return false;
+        };
+    };
+    return true;
+};
+
+/* -------------------------------------------------------
+ * @brief Sample from Raw16 humidity and temperature
+ * ------------------------------------------------------- */
+static void _test_Raw16(uint16_t _Humi, uint16_t _Temp, uint8_t* _Packed)
+{
+    _Packed[0] = _Humi >> 8;
+    _Packed[1] = _Humi;
+    _Packed[2] = _Temp >> 12;
+    _Packed[3] = _Temp >> 4;
+    _Packed[4] = _Temp << 4;
+};
+
+/* -------------------------------------------------------
+ * @brief One acquisition cycle as in the aht20_log.h usage example
+ * ------------------------------------------------------- */
+static void _test_Acquire(const uint8_t* _Packed)
+{
+    aht20_logService();                                    /**< Right after aht20_Trigger() */
+    delay_ms(__AHT20_MEASURE_DELAY);                       /**< Sensor converts, flash erases */
+    aht20_logAppend(_Packed);
+};
+
+static void _test_Fill(uint32_t _From, uint32_t _To)
+{
+    uint8_t _Packed[__AHT20_PACKED_SIZE];
+
+    for(uint32_t _Idx = _From; _Idx < _To; _Idx++)
+    {
+        _test_Sample(_Idx, _Packed);
+        _test_Acquire(_Packed);
+    };
+};
+
+/* -------------------------------------------------------
+ * @brief Count records of [_From, _To) that hold sample _First + offset
+ * ------------------------------------------------------- */
+static uint32_t _test_Verify(uint32_t _From, uint32_t _To, uint32_t _First)
+{
+    uint8_t  _Packed[__AHT20_PACKED_SIZE];
+    uint32_t _Good = 0;
+
+    for(uint32_t _Rec = _From; _Rec != _To; _Rec = (_Rec + 1) % __AHT20_LOG_RECORDS)
+    {
+        if((aht20_logRead(_Rec, _Packed) == AHT20_Res_OK) && _test_isSample(_First, _Packed))
+        {
+            _Good++;
+        };
+        _First++;
+    };
+    return _Good;
+};
+
+/* -------------------------------------------------------
+ * @brief Records that survive a reset when _Next samples were appended
+ * ------------------------------------------------------- */
+static uint32_t _test_Durable(uint32_t _Next)
+{
+    uint32_t _Pending = _Next % __TEST_RECS;               /**< Records in the RAM page buffer */
+
+#if __AHT20_LOG_FLUSH
+    _Pending %= __AHT20_LOG_FLUSH;                         /**< Group commits are in flash */
+#endif
+    return _Next - _Pending;
+};
+
+static void _test_Start(const char* _Name, uint8_t _Fill)
+{
+    printf("%s\n", _Name);
+    flash_Reset(_Fill);
+    aht20_logInit();
+};
+
+
+/* ============================================================================
+ *                       TESTS
+ * ============================================================================ */
+
+static void _test_Readback(void)
+{
+    uint32_t _Count = 20 * __TEST_RECS + 7;
+
+    _test_Start("readback", 0xFF);
+    _test_Fill(0, _Count);
+
+    CHECK(aht20_logNext() == _Count);
+    CHECK(_test_Verify(0, _Count, 0) == _Count);
+    CHECK(aht20_logOldest() == 0);
+    CHECK(flash_Stats.Faults == 0);
+#if __AHT20_LOG_FLUSH == 0
+    CHECK(flash_Stats.Programs == _Count / __TEST_RECS);   /**< One program per full page */
+#endif
+    CHECK(flash_Stats.StallUs < 1000);                     /**< Erases hidden in the conversion window */
+};
+
+static void _test_Stall(void)
+{
+    uint8_t _Packed[__AHT20_PACKED_SIZE];
+
+    _test_Start("stall", 0xFF);
+    delay_ms(__AHT20_MEASURE_DELAY);                       /**< Initial erase done */
+    for(uint32_t _Idx = 0; _Idx < __AHT20_LOG_SECTOR_RECS + __TEST_RECS; _Idx++)
+    {
+        _test_Sample(_Idx, _Packed);
+        aht20_logAppend(_Packed);                          /**< No aht20_logService() */
+    };
+
+    CHECK(flash_Stats.StallUs >= __FLASH_T_SE - __FLASH_T_PP);  /**< Next page program waited for the erase */
+    CHECK(flash_Stats.Faults == 0);
+};
+
+static void _test_DirtyChip(uint8_t _Fill)
+{
+    uint32_t _Count = __AHT20_LOG_SECTOR_RECS + 3 * __TEST_RECS;
+
+    _test_Start(_Fill ? "dirty chip, partly programmed" : "dirty chip", _Fill);
+    _test_Fill(0, _Count);
+
+    CHECK(aht20_logNext() == _Count);
+    CHECK(_test_Verify(0, _Count, 0) == _Count);
+    CHECK(aht20_logOldest() == 0);                         /**< Leftovers ahead are not taken for a wrapped ring */
+    CHECK(flash_Stats.Faults == 0);                        /**< Never programmed over unerased bytes */
+};
+
+static void _test_Wrap(void)
+{
+    uint32_t _Count = __AHT20_LOG_RECORDS + 3 * __AHT20_LOG_SECTOR_RECS + 20;
+    uint32_t _Oldest, _Next, _Kept, _Pos, _Exported = 0;
+    uint16_t _Humi[100], _Temp[100], _MaxErase = 0;
+    uint8_t  _Got;
+
+    _test_Start("wrap", 0xFF);
+    _test_Fill(0, _Count);
+
+    _Oldest = aht20_logOldest();
+    _Next = aht20_logNext();
+    _Kept = (_Next + __AHT20_LOG_RECORDS - _Oldest) % __AHT20_LOG_RECORDS;
+    CHECK(_Next == _Count % __AHT20_LOG_RECORDS);
+    CHECK(_Oldest % __AHT20_LOG_SECTOR_RECS == 0);
+    CHECK(_Kept > __AHT20_LOG_RECORDS - 2 * __AHT20_LOG_SECTOR_RECS);  /**< At most the erased sector ahead is lost */
+    CHECK(_test_Verify(_Oldest, _Next, _Count - _Kept) == _Kept);
+
+    _Pos = _Oldest;
+    while((_Got = aht20_logExport(&_Pos, _Next, _Humi, _Temp, 100)) != 0)
+    {
+        _Exported += _Got;
+    };
+    CHECK(_Exported == _Kept);
+    CHECK(_Pos == _Next);
+
+    for(uint16_t _Sector = 0; _Sector < __FLASH_SECTORS; _Sector++)
+    {
+        if(flash_Stats.SectorErases[_Sector] > _MaxErase)
+        {
+            _MaxErase = flash_Stats.SectorErases[_Sector];
+        };
+    };
+    CHECK(_MaxErase <= 2);                                 /**< Wear is spread over the whole ring */
+    CHECK(flash_Stats.Faults == 0);
+#if __AHT20_LOG_FLUSH == 0
+    CHECK(flash_Stats.PageProgramsMax == 1);               /**< No partial page programs */
+#endif
+
+    aht20_logInit();                                       /**< Reset after the wrap */
+    CHECK(aht20_logNext() == _test_Durable(_Next));
+    CHECK(aht20_logOldest() == _Oldest);
+};
+
+static void _test_Recovery(void)
+{
+    uint32_t _Count = 3 * __TEST_RECS + 23;
+    uint32_t _Kept = _test_Durable(_Count);
+    uint8_t  _Packed[__AHT20_PACKED_SIZE];
+
+    _test_Start("recovery", 0xFF);
+    _test_Fill(0, _Count);
+    aht20_logInit();                                       /**< Reset: RAM page buffer lost */
+
+    CHECK(aht20_logNext() == _Kept);
+    CHECK(_test_Verify(0, _Kept, 0) == _Kept);
+    CHECK(aht20_logRead(_Kept, _Packed) == AHT20_Res_ERR);
+
+    _test_Fill(_Kept, _Kept + 2 * __TEST_RECS);            /**< Continue behind the replayed records */
+    CHECK(_test_Verify(0, _Kept + 2 * __TEST_RECS, 0) == _Kept + 2 * __TEST_RECS);
+
+    _test_Fill(_Kept + 2 * __TEST_RECS, _Kept + 2 * __TEST_RECS + 3);
+    aht20_logFlush();                                      /**< Explicit flush before power down */
+    aht20_logInit();
+    CHECK(aht20_logNext() == _Kept + 2 * __TEST_RECS + 3);
+    CHECK(_test_Verify(0, _Kept + 2 * __TEST_RECS + 3, 0) == _Kept + 2 * __TEST_RECS + 3);
+    CHECK(flash_Stats.Faults == 0);
+};
+
+static void _test_Search(void)
+{
+    uint32_t _Count = 200 * __TEST_RECS + 20;              /**< Last 20 samples still in RAM */
+    uint32_t _Pages = _Count / __TEST_RECS;
+    uint32_t _Rec, _Reads;
+    uint8_t  _Packed[__AHT20_PACKED_SIZE];
+
+    _test_Start("search", 0xFF);
+    for(uint32_t _Idx = 0; _Idx < _Count; _Idx++)
+    {
+        bool _Spike = (_Idx == 3000) || (_Idx == 7777) || (_Idx == _Count - 10);
+
+        _test_Raw16(_Spike ? 0xE000 : 0x4000 + (_Idx & 0xFF), 0x8000, _Packed);  /**< ~25%RH, spikes ~87.5%RH, 50°C */
+        _test_Acquire(_Packed);
+    };
+
+    _Reads = flash_Stats.Reads;
+    _Rec = 0;
+    CHECK((aht20_logFindAbove(false, 8000, &_Rec, aht20_logNext()) == AHT20_Res_OK) && (_Rec == 3000));
+    _Rec++;
+    CHECK((aht20_logFindAbove(false, 8000, &_Rec, aht20_logNext()) == AHT20_Res_OK) && (_Rec == 7777));
+    _Rec++;
+    CHECK((aht20_logFindAbove(false, 8000, &_Rec, aht20_logNext()) == AHT20_Res_OK) && (_Rec == _Count - 10));
+    _Rec++;
+    CHECK(aht20_logFindAbove(false, 8000, &_Rec, aht20_logNext()) == AHT20_Res_ERR);
+    CHECK(flash_Stats.Reads - _Reads <= _Pages + 2 * __TEST_RECS);  /**< Zone map per page, records of 2 candidate pages */
+
+    _Rec = 3001;
+    CHECK(aht20_logFindAbove(false, 8000, &_Rec, 7777) == AHT20_Res_ERR);  /**< End is exclusive */
+    _Rec = 3001;
+    CHECK((aht20_logFindAbove(false, 8000, &_Rec, 7778) == AHT20_Res_OK) && (_Rec == 7777));
+
+    _Rec = 0;
+    CHECK((aht20_logFindAbove(true, 4900, &_Rec, aht20_logNext()) == AHT20_Res_OK) && (_Rec == 0));
+    _Rec = 0;
+    CHECK(aht20_logFindAbove(true, 5100, &_Rec, aht20_logNext()) == AHT20_Res_ERR);
+};
+
+
+/* ============================================================================
+ *                       MAIN
+ * ============================================================================ */
+
+int main(void)
+{
+    printf("aht20_log, __AHT20_LOG_FLUSH = %d\n", __AHT20_LOG_FLUSH);
+
+    _test_Readback();
+    _test_Stall();
+    _test_DirtyChip(0x00);
+    _test_DirtyChip(0x5A);
+    _test_Wrap();
+    _test_Recovery();
+    _test_Search();
+
+    printf("%s (%lu failed checks)\n", _testFailed ? "FAILED" : "PASSED", (unsigned long)_testFailed);
+    return _testFailed ? 1 : 0;
+};
@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file     test_seq.c
+ * @brief    Host tests of the receiver side sequence tracker (aht20_seqCheck)
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     TESTS:
+ *           - In order, gaps and duplicates
+ *           - Late arrival inside the 32 sample window fills its gap
+ *           - Older than the window counts as Late, not as duplicate
+ *           - Numbers below the first one received are duplicates
+ *           - 16-bit wrap-around
+ ******************************************************************************
+ */
+
+#include "aht20.h"
+#include <stdio.h>
+
+
+static uint32_t _testFailed = 0;
+
+#define CHECK(_Cond)                                                            \
+    do                                                                          \
+    {                                                                           \
+        if(!(_Cond))                                                            \
+        {                                                                       \
+            printf("  FAIL line %d: %s\n", __LINE__, #_Cond);                   \
+            _testFailed++;                                                      \
+        };                                                                      \
+    } while(0)
+
+
+/* -------------------------------------------------------
+ * @brief Feed a list of numbers, return how many were accepted
+ * ------------------------------------------------------- */
+static uint8_t _test_Feed(AHT20_SeqTrack_T* _Track, const uint16_t* _Seq, uint8_t _Count)
+{
+    uint8_t _Accepted = 0;
+
+    for(uint8_t _Idx = 0; _Idx < _Count; _Idx++)
+    {
+        _Accepted += aht20_seqCheck(_Track, _Seq[_Idx]) ? 1 : 0;
+    };
+    return _Accepted;
+};
+
+int main(void)
+{
+    printf("aht20_seqCheck\n");
+
+    {
+        AHT20_SeqTrack_T _Track = {0};
+        const uint16_t   _Seq[] = {10, 11, 11, 14, 15};
+
+        CHECK(_test_Feed(&_Track, _Seq, 5) == 4);
+        CHECK((_Track.Gaps == 2) && (_Track.Dups == 1) && (_Track.Late == 0));
+    }
+
+    {
+        AHT20_SeqTrack_T _Track = {0};
+        const uint16_t   _Seq[] = {5, 6, 8, 7};
+
+        CHECK(_test_Feed(&_Track, _Seq, 4) == 4);          /**< Late 7 is not lost */
+        CHECK((_Track.Gaps == 0) && (_Track.Dups == 0) && (_Track.Late == 0));
+        CHECK(!aht20_seqCheck(&_Track, 7));                /**< Second copy is a duplicate */
+        CHECK(_Track.Dups == 1);
+    }
+
+    {
+        AHT20_SeqTrack_T _Track = {0};
+        const uint16_t   _Seq[] = {100, 140, 108, 109, 139};
+
+        CHECK(_test_Feed(&_Track, _Seq, 5) == 4);          /**< Window is 140..109: only 108 is too old */
+        CHECK((_Track.Late == 1) && (_Track.Dups == 0));
+        CHECK(_Track.Gaps == 39 - 2);                      /**< 109 and 139 filled two of the 39 missing */
+    }
+
+    {
+        AHT20_SeqTrack_T _Track = {0};
+        const uint16_t   _Seq[] = {10, 9, 8};
+
+        CHECK(_test_Feed(&_Track, _Seq, 2) == 1);          /**< 9 comes before the start point */
+        CHECK((_Track.Gaps == 0) && (_Track.Dups == 1));
+        CHECK(_test_Feed(&_Track, &_Seq[2], 1) == 0);
+        CHECK((_Track.Gaps == 0) && (_Track.Dups == 2) && (_Track.Next == 11));
+    }
+
+    {
+        AHT20_SeqTrack_T _Track = {0};
+        const uint16_t   _Seq[] = {65534, 65535, 1, 0, 65535, 2};
+
+        CHECK(_test_Feed(&_Track, _Seq, 6) == 5);
+        CHECK((_Track.Gaps == 0) && (_Track.Dups == 1) && (_Track.Next == 3));
+    }
+
+    printf("%s (%lu failed checks)\n", _testFailed ? "FAILED" : "PASSED", (unsigned long)_testFailed);
+    return _testFailed ? 1 : 0;
+};
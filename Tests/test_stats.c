@@ -0,0 +1,230 @@
+/**
+ ******************************************************************************
+ * @file     test_stats.c
+ * @brief    Host tests of the mergeable summaries (aht20_stats.c)
+ *
+ * @author   Hossein Bagheri
+ * @github   https://github.com/aKaReZa75
+ *
+ * @note     TESTS:
+ *           - Merge      : Merging two summaries equals one summary of all samples
+ *           - Percentile : Interpolation inside a bin, clamping to min/max
+ *           - Anomaly    : No flags during warm-up, a step is flagged afterwards,
+ *                          noise at the __AHT20_ANOM_FLOOR level is not
+ *           - Rollup     : Bucket rotation, late samples, 16-bit Id wrap
+ ******************************************************************************
+ */
+
+#include "aht20_stats.h"
+#include <stdio.h>
+#include <string.h>
+
+
+static uint32_t _testFailed = 0;
+
+#define CHECK(_Cond)                                                            \
+    do                                                                          \
+    {                                                                           \
+        if(!(_Cond))                                                            \
+        {                                                                       \
+            printf("  FAIL line %d: %s\n", __LINE__, #_Cond);                   \
+            _testFailed++;                                                      \
+        };                                                                      \
+    } while(0)
+
+
+/* ============================================================================
+ *                       HELPERS
+ * ============================================================================ */
+
+/* -------------------------------------------------------
+ * @brief Build 5 packed bytes from Raw16 humidity and temperature
+ * ------------------------------------------------------- */
+static void _test_Raw16(uint16_t _Humi, uint16_t _Temp, uint8_t* _Packed)
+{
+    _Packed[0] = (uint8_t)(_Humi >> 8);
+    _Packed[1] = (uint8_t)(_Humi);
+    _Packed[2] = (uint8_t)(_Temp >> 12);
+    _Packed[3] = (uint8_t)(_Temp >> 4);
+    _Packed[4] = (uint8_t)(_Temp << 4);
+};
+
+static void _test_Add(AHT20_Stats_T* _Stats, uint16_t _Humi, uint16_t _Temp)
+{
+    uint8_t _Packed[__AHT20_PACKED_SIZE];
+
+    _test_Raw16(_Humi, _Temp, _Packed);
+    CHECK(aht20_statsAdd(_Stats, _Packed));
+};
+
+
+/* ============================================================================
+ *                       TESTS
+ * ============================================================================ */
+
+static void _test_Merge(void)
+{
+    AHT20_Stats_T _A, _B, _All;
+
+    printf("merge\n");
+    memset(&_A, 0, sizeof(_A));                            /**< Host struct padding compares equal too */
+    memset(&_B, 0, sizeof(_B));
+    memset(&_All, 0, sizeof(_All));
+    aht20_statsClear(&_A);
+    aht20_statsClear(&_B);
+    aht20_statsClear(&_All);
+
+    for(uint16_t _Idx = 0; _Idx < 300; _Idx++)            /**< Two sensors, overlapping ranges */
+    {
+        uint16_t _Humi = (uint16_t)(20000 + _Idx * 97);
+        uint16_t _Temp = (uint16_t)(30000 - _Idx * 13);
+
+        _test_Add((_Idx & 1) ? &_A : &_B, _Humi, _Temp);
+        _test_Add(&_All, _Humi, _Temp);
+    };
+    _test_Add(&_B, 65535, 0);                              /**< Extremes only in B */
+    _test_Add(&_All, 65535, 0);
+    _A.Busy = 3;
+    _B.Busy = 4;
+    _B.Errors = 2;
+    _All.Busy = 7;
+    _All.Errors = 2;
+
+    CHECK(aht20_statsMerge(&_A, &_B));
+    CHECK(memcmp(&_A, &_All, sizeof(_A)) == 0);            /**< Merge is plain addition */
+    CHECK(aht20_statsHumiPct(&_A, 90) == aht20_statsHumiPct(&_All, 90));
+    CHECK(aht20_statsHumiMean(&_A) == aht20_statsHumiMean(&_All));
+    CHECK(aht20_statsTempMean(&_A) == aht20_statsTempMean(&_All));
+
+    aht20_statsClear(&_B);                                 /**< Merging an empty summary changes nothing */
+    CHECK(aht20_statsMerge(&_A, &_B));
+    CHECK(memcmp(&_A, &_All, sizeof(_A)) == 0);
+
+    _B.Count = 0xFFFF - 300;                               /**< Combined count above 65535 */
+    CHECK(!aht20_statsMerge(&_A, &_B));
+    CHECK(memcmp(&_A, &_All, sizeof(_A)) == 0);            /**< Refused merge leaves _Dst unchanged */
+};
+
+static void _test_Percentile(void)
+{
+    AHT20_Stats_T _Stats;
+
+    printf("percentile\n");
+    aht20_statsClear(&_Stats);
+    CHECK(aht20_statsHumiPct(&_Stats, 50) == 0);           /**< Empty summary */
+
+    _test_Add(&_Stats, 32768, 0);                          /**< Bin 10: Raw16 32768..36044 (50..55%RH) */
+    _test_Add(&_Stats, 33000, 0);
+    _test_Add(&_Stats, 35000, 0);
+    _test_Add(&_Stats, 36043, 0);
+    CHECK(aht20_statsHumiPct(&_Stats, 0) == 5124);         /**< Rank 1 of 4: a quarter into the bin */
+    CHECK(aht20_statsHumiPct(&_Stats, 50) == 5249);        /**< Rank 2 of 4: half way */
+    CHECK(aht20_statsHumiPct(&_Stats, 100) == 5499);       /**< Bin top clamped to the maximum */
+
+    aht20_statsClear(&_Stats);
+    for(uint8_t _Idx = 0; _Idx < 4; _Idx++)
+    {
+        _test_Add(&_Stats, 42000, 0);                      /**< Near the top of bin 12 */
+    };
+    CHECK(aht20_statsHumiPct(&_Stats, 0) == 6408);         /**< Interpolated 40140 clamped up to the minimum */
+    CHECK(aht20_statsHumiPct(&_Stats, 100) == 6408);
+
+    aht20_statsClear(&_Stats);
+    _test_Add(&_Stats, 40000, 0);
+    CHECK(aht20_statsHumiPct(&_Stats, 0) == 6103);         /**< Single sample: every percentile is the sample */
+    CHECK(aht20_statsHumiPct(&_Stats, 100) == 6103);
+};
+
+
+static void _test_Anomaly(void)
+{
+    static const int8_t _Noise[] = {0, 3, -4, 5, -2, -5, 4, 1, -3, 2};  /**< Within ±5 = std of the variance floor */
+    AHT20_Anom_T _Anom;
+    uint16_t     _Flags = 0;
+
+    printf("anomaly\n");
+    aht20_anomInit(&_Anom);
+
+    CHECK(!aht20_anomCheck(&_Anom, 2500));
+    CHECK(!aht20_anomCheck(&_Anom, 4000));                 /**< Step during warm-up is not flagged */
+    aht20_anomInit(&_Anom);
+
+    for(uint16_t _Idx = 0; _Idx < 500; _Idx++)            /**< Flat signal with floor-level noise */
+    {
+        _Flags += aht20_anomCheck(&_Anom, 2500 + _Noise[_Idx % sizeof(_Noise)]) ? 1 : 0;
+    };
+    CHECK(_Flags == 0);
+    CHECK(_Anom.Count == (1 << __AHT20_ANOM_SHIFT));       /**< Warm-up counter stopped at 2^n */
+
+    CHECK(aht20_anomCheck(&_Anom, 2500 + 200));            /**< 2.00 step: far outside 4 std */
+    CHECK(!aht20_anomCheck(&_Anom, 2500));                 /**< Back to normal: variance grew with the step */
+};
+
+
+static void _test_Rollup(void)
+{
+    AHT20_Rollup_T _Roll;
+    uint8_t        _Packed[__AHT20_PACKED_SIZE];
+
+    printf("rollup, __AHT20_ROLLUP_SIZE = %d\n", __AHT20_ROLLUP_SIZE);
+    _test_Raw16(32768, 32768, _Packed);
+    aht20_rollupInit(&_Roll);
+    CHECK(aht20_rollupGet(&_Roll, 0) == NULL);             /**< Nothing before the first sample */
+
+    /* Rotation: each new Id reuses the slot of the oldest bucket */
+    for(uint16_t _Id = 10; _Id < 10 + __AHT20_ROLLUP_SIZE; _Id++)
+    {
+        CHECK(aht20_rollupAdd(&_Roll, _Id, _Packed));
+    };
+    CHECK(aht20_rollupGet(&_Roll, 10)->Count == 1);
+    CHECK(aht20_rollupAdd(&_Roll, 10 + __AHT20_ROLLUP_SIZE, _Packed));
+    CHECK(aht20_rollupGet(&_Roll, 10) == NULL);            /**< Dropped */
+    CHECK(aht20_rollupGet(&_Roll, 10 + __AHT20_ROLLUP_SIZE)->Count == 1);  /**< Slot cleared before reuse */
+    CHECK(aht20_rollupGet(&_Roll, 11)->Count == 1);
+    CHECK(aht20_rollupGet(&_Roll, 11 + __AHT20_ROLLUP_SIZE) == NULL);  /**< Future bucket */
+
+    /* Late samples: accepted while their bucket is in the ring */
+    CHECK(aht20_rollupAdd(&_Roll, 11, _Packed));
+    CHECK(aht20_rollupGet(&_Roll, 11)->Count == 2);
+    CHECK(aht20_rollupGet(&_Roll, 10 + __AHT20_ROLLUP_SIZE)->Count == 1);  /**< Newest untouched */
+    CHECK(!aht20_rollupAdd(&_Roll, 10, _Packed));          /**< Bucket already reused */
+    CHECK(aht20_rollupGet(&_Roll, 11)->Count == 2);
+
+    /* Jump further than the ring: every bucket reopens empty */
+    CHECK(aht20_rollupAdd(&_Roll, 100, _Packed));
+    CHECK(aht20_rollupGet(&_Roll, 100)->Count == 1);
+    CHECK(aht20_rollupGet(&_Roll, 101 - __AHT20_ROLLUP_SIZE)->Count == 0);
+    CHECK(aht20_rollupGet(&_Roll, 100 - __AHT20_ROLLUP_SIZE) == NULL);
+
+    /* 16-bit Id wrap: 65535 → 0 is one bucket step */
+    aht20_rollupInit(&_Roll);
+    CHECK(aht20_rollupAdd(&_Roll, 65535, _Packed));
+    CHECK(aht20_rollupAdd(&_Roll, 0, _Packed));
+    CHECK(_Roll.Newest == 0);
+    CHECK(aht20_rollupGet(&_Roll, 65535)->Count == 1);     /**< Still in the ring across the wrap */
+    CHECK(aht20_rollupAdd(&_Roll, 65535, _Packed));        /**< Late sample across the wrap */
+    CHECK(aht20_rollupGet(&_Roll, 65535)->Count == 2);
+    CHECK(aht20_rollupGet(&_Roll, 0)->Count == 1);
+    CHECK(aht20_rollupAdd(&_Roll, __AHT20_ROLLUP_SIZE - 1, _Packed));
+    CHECK(aht20_rollupGet(&_Roll, 65535) == NULL);         /**< Dropped by Id SIZE - 1 */
+    CHECK(!aht20_rollupAdd(&_Roll, 65535, _Packed));
+    CHECK(aht20_rollupGet(&_Roll, 0)->Count == 1);
+};
+
+
+/* ============================================================================
+ *                       MAIN
+ * ============================================================================ */
+
+int main(void)
+{
+    printf("aht20_stats\n");
+
+    _test_Merge();
+    _test_Percentile();
+    _test_Anomaly();
+    _test_Rollup();
+
+    printf("%s (%lu failed checks)\n", _testFailed ? "FAILED" : "PASSED", (unsigned long)_testFailed);
+    return _testFailed ? 1 : 0;
+};